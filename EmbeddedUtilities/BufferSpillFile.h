@@ -0,0 +1,104 @@
+#ifndef BUFFER_SPILL_FILE_H
+#define BUFFER_SPILL_FILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "EmbeddedUtilities/MultiReaderBuffer.h"
+
+/**
+ * \file EmbeddedUtilities/BufferSpillFile.h
+ *
+ * An overflow tier on disk for a durable reader of a MultiReaderBuffer on hosted targets.
+ * Items the reader has not read yet are appended to a memory mapped file instead of being overwritten
+ * (see setBufferSpillHandler), so the buffer itself stays small and the reader loses nothing during bursts.
+ * The reader pops via popFromBufferWithSpillFile, which drains the file before it continues with the buffer.
+ *
+ * The file grows by whole segments while the reader falls behind and shrinks back to a single segment
+ * once it has been drained. It is removed from the file system right after it has been created,
+ * so no stale file is left behind if the process terminates.
+ * Like the MultiReaderBuffer itself, the spill file is not thread-safe.
+ */
+
+/*!
+ * @struct BufferSpillFile
+ *
+ * @brief	The state of the spill file of a durable reader.
+ */
+typedef struct BufferSpillFile
+{
+	Buffer *buffer;	//!< The buffer the durable reader belongs to
+	uint8_t reader_descriptor;	//!< The descriptor of the durable reader
+	size_t word_size_in_byte;	//!< The size of the items in byte
+	size_t segment_size_in_byte;	//!< The file grows and shrinks in steps of this size
+	int file_descriptor;	//!< The open file
+	uint8_t *mapping;	//!< Start address of the file mapping
+	size_t mapping_size;	//!< The current size of the file and its mapping
+	size_t read_offset;	//!< Offset of the oldest spilled item that has not been read yet
+	size_t write_offset;	//!< Offset the next spilled item is appended at
+	size_t lost_elements;	//!< Number of items that could not be written to the file, e.g. since the disk is full
+} BufferSpillFile;
+
+/*!
+ * @brief	Creates a spill file and makes the reader the durable reader of the buffer.
+ *
+ * @param self
+ * 	The spill file to be set up
+ * @param buffer
+ * 	The buffer, which must not reject items (MULTI_READER_BUFFER_REJECT_WHEN_FULL)
+ * @param reader_descriptor
+ * 	A valid descriptor of the reader that should not lose items
+ * @param path
+ * 	The path of the file to create; an existing file is replaced
+ * @param segment_size
+ * 	The number of items the file grows by at once; items are also spilled in batches of this size (at most max_elements)
+ *
+ * @returns
+ * 	BUFFER_OK, or BUFFER_UNAVAILABLE if the file could not be created or mapped
+ *
+ * @throws BUFFER_INVALID_READER_EXCEPTION
+ * 	An exception is thrown if the reader descriptor is invalid
+ */
+BufferStatus
+openBufferSpillFile(BufferSpillFile *self, Buffer *buffer, uint8_t reader_descriptor, const char *path, size_t segment_size);
+
+/*!
+ * @brief	Removes the spill handler from the buffer and releases the file.
+ *
+ * Items still in the file are discarded.
+ *
+ * @param self
+ * 	The spill file
+ */
+void
+closeBufferSpillFile(BufferSpillFile *self);
+
+/*!
+ * @brief	Copies the oldest unread item of the durable reader, from the file if possible, and advances the reader.
+ *
+ * @param self
+ * 	The spill file
+ * @param destination
+ * 	Memory of at least word_size bytes the item is copied to
+ *
+ * @returns
+ * 	BUFFER_OK if an item has been copied;
+ * 	BUFFER_EMPTY if there is nothing to read;
+ * 	BUFFER_OVERRUN once the file has been drained, if items could not be written to it
+ */
+BufferStatus
+popFromBufferWithSpillFile(BufferSpillFile *self, void *destination);
+
+/*!
+ * @brief	Returns the number of items waiting in the file.
+ *
+ * @param self
+ * 	The spill file
+ *
+ * @returns
+ * 	The number of spilled items that have not been read yet
+ */
+size_t
+getNumberOfSpilledElements(const BufferSpillFile *self);
+
+#endif
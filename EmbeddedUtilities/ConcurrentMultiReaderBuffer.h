@@ -0,0 +1,333 @@
+#ifndef CONCURRENT_MULTI_READER_BUFFER_H
+#define CONCURRENT_MULTI_READER_BUFFER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "EmbeddedUtilities/MultiReaderBuffer.h"
+
+/**
+ * \file EmbeddedUtilities/ConcurrentMultiReaderBuffer.h
+ *
+ * A thread-safe variant of the MultiReaderBuffer for hosted multicore targets
+ * (requires C11 atomics). One producer thread and any number of consumer threads
+ * can use the buffer at the same time without locks.
+ *
+ * Positions are free-running 64 bit sequence numbers: the producer publishes the number
+ * of items written so far and stamps every slot with the sequence number of the item it holds.
+ * A consumer copies an item out of its slot and afterwards checks the stamp again.
+ * Slots are copied with relaxed atomic accesses, so this is no data race and tools like
+ * ThreadSanitizer need no suppressions.
+ * If the producer has overwritten the slot in the meantime, the item is discarded
+ * and the overrun is reported, just as with the single threaded MultiReaderBuffer.
+ * Each reader cursor lives on its own cache line, so consumers do not slow each other down.
+ *
+ * With MULTI_READER_BUFFER_MULTIPLE_PRODUCERS, several producer threads may push at the same time.
+ * Each producer claims a sequence number with an atomic fetch-add (or a compare-and-swap if the
+ * buffer must not overwrite unread items) and stamps its slot when the item has been copied.
+ * The published sequence number only advances over consecutively stamped slots, so readers
+ * see the items in the order of their sequence numbers, exactly as with a single producer.
+ *
+ * Reader groups distribute the items among several consumer threads instead of broadcasting them.
+ * A group occupies a single reader slot whose cursor is shared by its consumers: a consumer copies
+ * the next item and then claims it by advancing the cursor with a compare-and-swap, so each item is
+ * handed to exactly one consumer of the group. All other readers and groups still see every item.
+ *
+ * Since CException keeps its frames in a global variable by default, none of these functions throw.
+ * Errors are reported via BufferStatus instead.
+ */
+
+/*!
+ * @define CONCURRENT_MULTI_READER_BUFFER_CACHE_LINE_SIZE
+ *
+ * @brief	The alignment used to keep the shared state of producer and readers apart.
+ *
+ * The memory handed to initConcurrentMultiReaderBuffer must be aligned to this size.
+ */
+#define CONCURRENT_MULTI_READER_BUFFER_CACHE_LINE_SIZE (64)
+
+typedef struct ConcurrentMultiReaderBuffer ConcurrentMultiReaderBuffer;
+
+/*!
+ * @struct ConcurrentBufferReader
+ *
+ * @brief	The state of a single reader slot, padded to a full cache line.
+ */
+typedef struct ConcurrentBufferReader
+{
+	_Alignas(CONCURRENT_MULTI_READER_BUFFER_CACHE_LINE_SIZE) _Atomic uint64_t sequence;	//!< Sequence number of the next item to be read
+	_Atomic uint8_t state;	//!< Current reader state (see BufferReaderState)
+	bool is_group;	//!< Whether the slot is shared by the consumers of a reader group
+} ConcurrentBufferReader;
+
+/*!
+ * @brief	Initializes a concurrent multi reader buffer.
+ *
+ * Needs to be called before any other thread accesses the buffer.
+ * The memory should be created using CONCURRENT_MULTI_READER_BUFFER_SIZE with the same
+ * set of parameters and be aligned to CONCURRENT_MULTI_READER_BUFFER_CACHE_LINE_SIZE.
+ *
+ * @param self
+ * 	Pointer to the memory that should be used for the buffer
+ * @param word_size
+ * 	The size in byte of the individual data items that should be managed in the buffer
+ * @param max_elements
+ * 	The maximum number of elements that the buffer should be able to hold at once; must be a power of two
+ * @param max_readers
+ * 	The maximum number of buffer readers that are allowed to exist in parallel
+ *
+ * @returns
+ * 	BUFFER_OK, or BUFFER_INVALID_CAPACITY if max_elements is not a power of two
+ */
+BufferStatus
+initConcurrentMultiReaderBuffer(ConcurrentMultiReaderBuffer *self, size_t word_size, size_t max_elements, size_t max_readers);
+
+/*!
+ * @brief	Initializes a concurrent multi reader buffer with a set of options.
+ *
+ * Same as initConcurrentMultiReaderBuffer, but allows to select the policy for a full buffer:
+ * MULTI_READER_BUFFER_REJECT_WHEN_FULL lets pushToConcurrentBuffer return BUFFER_FULL,
+ * MULTI_READER_BUFFER_BLOCK_WHEN_FULL makes it wait until the slowest reader has advanced.
+ * Without either, the oldest items are overwritten. The capacity is always a power of two.
+ * MULTI_READER_BUFFER_MULTIPLE_PRODUCERS allows several producer threads.
+ *
+ * @param self
+ * 	Pointer to the memory that should be used for the buffer
+ * @param word_size
+ * 	The size in byte of the individual data items that should be managed in the buffer
+ * @param max_elements
+ * 	The maximum number of elements that the buffer should be able to hold at once; must be a power of two
+ * @param max_readers
+ * 	The maximum number of buffer readers that are allowed to exist in parallel
+ * @param options
+ * 	Bitwise combination of MultiReaderBufferOption values
+ *
+ * @returns
+ * 	BUFFER_OK, or BUFFER_INVALID_CAPACITY if max_elements is not a power of two
+ */
+BufferStatus
+initConcurrentMultiReaderBufferWithOptions(ConcurrentMultiReaderBuffer *self, size_t word_size, size_t max_elements, size_t max_readers, MultiReaderBufferOptions options);
+
+/*!
+ * @brief	Writes new data into the buffer.
+ *
+ * By default never waits for readers. Like pushToBuffer, the oldest items are overwritten once the buffer is full.
+ * With MULTI_READER_BUFFER_BLOCK_WHEN_FULL the producer waits instead until every active reader
+ * has room for the item, so a reader that stops reading stalls the producer until it is deleted.
+ * Must only be called from a single producer thread, unless the buffer has been initialized
+ * with MULTI_READER_BUFFER_MULTIPLE_PRODUCERS. In that case a producer also waits if the item
+ * one lap ahead of it has not been published yet, which only happens if more than max_elements
+ * pushes are in progress at once.
+ *
+ * @param self
+ * 	A pointer to the buffer
+ * @param data
+ * 	The data that should be written into the buffer
+ *
+ * @returns
+ * 	BUFFER_OK, or BUFFER_FULL if the item has been rejected (MULTI_READER_BUFFER_REJECT_WHEN_FULL)
+ */
+BufferStatus
+pushToConcurrentBuffer(ConcurrentMultiReaderBuffer *self, const void *data);
+
+/*!
+ * @brief	Returns how many items can be pushed before the slowest active reader would lose data.
+ *
+ * Readers only ever advance, so the result is a lower bound if they are reading concurrently.
+ *
+ * @param self
+ * 	A pointer to the buffer
+ *
+ * @returns
+ * 	max_elements minus the number of unread items of the slowest active reader
+ */
+size_t
+getFreeSpaceOfConcurrentBuffer(const ConcurrentMultiReaderBuffer *self);
+
+/*!
+ * @brief	Claims a free reader slot.
+ *
+ * Can be called from any thread. The new reader starts at the oldest item in the buffer.
+ *
+ * @param self
+ * 	A pointer to the buffer
+ * @param reader_descriptor
+ * 	Returns the descriptor of the claimed reader
+ *
+ * @returns
+ * 	BUFFER_OK, or BUFFER_NO_FREE_READER_SLOTS if all reader slots are in use
+ */
+BufferStatus
+getNewConcurrentBufferReaderDescriptor(ConcurrentMultiReaderBuffer *self, uint8_t *reader_descriptor);
+
+/*!
+ * @brief	Claims a free reader slot for a group of consumers sharing the items.
+ *
+ * The descriptor can be used by several threads at once with popFromConcurrentBufferWithReader
+ * and waitForItemsWithConcurrentReader; each item is popped by exactly one of them.
+ * The group starts at the oldest item in the buffer and is released via deleteConcurrentBufferReaderDescriptor.
+ *
+ * @param self
+ * 	A pointer to the buffer
+ * @param group_descriptor
+ * 	Returns the descriptor of the claimed reader slot
+ *
+ * @returns
+ * 	BUFFER_OK, or BUFFER_NO_FREE_READER_SLOTS if all reader slots are in use
+ */
+BufferStatus
+getNewConcurrentBufferGroupDescriptor(ConcurrentMultiReaderBuffer *self, uint8_t *group_descriptor);
+
+/*!
+ * @brief	Releases a reader slot.
+ *
+ * @param self
+ * 	A pointer to the buffer
+ * @param reader_descriptor
+ * 	The descriptor of the reader that should be released
+ *
+ * @returns
+ * 	BUFFER_OK, or BUFFER_INVALID_READER if the descriptor does not correspond to an actual reader slot
+ */
+BufferStatus
+deleteConcurrentBufferReaderDescriptor(ConcurrentMultiReaderBuffer *self, uint8_t reader_descriptor);
+
+/*!
+ * @brief	Returns whether there is at least one unread item left for the reader.
+ *
+ * @param self
+ * 	A pointer to the buffer
+ * @param reader_descriptor
+ * 	The descriptor of the reader
+ *
+ * @returns
+ * 	true if the reader descriptor is valid and there are still elements left to be read
+ */
+bool
+readableItemExistsForConcurrentReader(const ConcurrentMultiReaderBuffer *self, uint8_t reader_descriptor);
+
+/*!
+ * @brief	Copies the oldest unread item of a reader and advances the reader.
+ *
+ * Items are copied since a slot can be overwritten by the producer at any time.
+ * Each reader descriptor must only be used by one thread at a time, except for group descriptors.
+ * A consumer of a group that loses the race for an item retries with the next one.
+ *
+ * @param self
+ * 	A pointer to the buffer
+ * @param reader_descriptor
+ * 	The descriptor of the reader with which the data should be retrieved
+ * @param destination
+ * 	Memory of at least word_size bytes the item is copied to
+ *
+ * @returns
+ * 	BUFFER_OK if an item has been copied;
+ * 	BUFFER_EMPTY if there is nothing to read;
+ * 	BUFFER_OVERRUN if items have been lost, the reader then points to the oldest item;
+ * 	BUFFER_INVALID_READER if the reader descriptor is invalid
+ */
+BufferStatus
+popFromConcurrentBufferWithReader(ConcurrentMultiReaderBuffer *self, uint8_t reader_descriptor, void *destination);
+
+/*!
+ * @brief	Returns the sequence number of the item a reader reads next.
+ *
+ * Items are numbered from 0 in the order they are published, see also seekConcurrentBufferReaderToSequenceNumber.
+ *
+ * @param self
+ * 	A pointer to the buffer
+ * @param reader_descriptor
+ * 	The descriptor of the reader
+ * @param sequence_number
+ * 	Returns the sequence number
+ *
+ * @returns
+ * 	BUFFER_OK, or BUFFER_INVALID_READER if the reader descriptor is invalid
+ */
+BufferStatus
+getConcurrentBufferReaderSequenceNumber(const ConcurrentMultiReaderBuffer *self, uint8_t reader_descriptor, uint64_t *sequence_number);
+
+/*!
+ * @brief	Moves a reader (or group) to the item with the given sequence number in constant time.
+ *
+ * The producer may overwrite the item right after the check, which the next pop reports as BUFFER_OVERRUN.
+ * Must not be called while the reader is popping in another thread. If the function fails, the reader is not moved.
+ *
+ * @param self
+ * 	A pointer to the buffer
+ * @param reader_descriptor
+ * 	The descriptor of the reader
+ * @param sequence_number
+ * 	The sequence number of the item the reader should read next
+ *
+ * @returns
+ * 	BUFFER_OK if the reader has been moved;
+ * 	BUFFER_EVICTED if the item has already been overwritten;
+ * 	BUFFER_EMPTY if no item with this sequence number has been published so far;
+ * 	BUFFER_INVALID_READER if the reader descriptor is invalid
+ */
+BufferStatus
+seekConcurrentBufferReaderToSequenceNumber(ConcurrentMultiReaderBuffer *self, uint8_t reader_descriptor, uint64_t sequence_number);
+
+/*!
+ * @brief	Blocks the calling thread until there is an unread item for the reader or the timeout expires.
+ *
+ * Lets consumer threads sleep instead of polling readableItemExistsForConcurrentReader.
+ * On Linux the thread sleeps on a futex inside the buffer memory, which also works across processes
+ * (see SharedMultiReaderBuffer). The producer only issues a wake-up call while readers are waiting.
+ * On other systems the function falls back to polling with sched_yield.
+ *
+ * @param self
+ * 	A pointer to the buffer
+ * @param reader_descriptor
+ * 	The descriptor of the reader
+ * @param timeout_in_milliseconds
+ * 	The maximum time to wait
+ *
+ * @returns
+ * 	BUFFER_OK if there is an item to read;
+ * 	BUFFER_EMPTY if the timeout has expired;
+ * 	BUFFER_INVALID_READER if the reader descriptor is invalid
+ */
+BufferStatus
+waitForItemsWithConcurrentReader(ConcurrentMultiReaderBuffer *self, uint8_t reader_descriptor, uint32_t timeout_in_milliseconds);
+
+/*!
+ * @define CONCURRENT_MULTI_READER_BUFFER_SIZE
+ *
+ * @brief	Expands to the number of bytes required to create a concurrent buffer with the provided parameters.
+ *
+ * In contrast to MULTI_READER_BUFFER_SIZE no position is "wasted", since the sequence numbers tell full and empty apart.
+ *
+ * @param word_size
+ * 	The size in byte of the individual data items that should be managed in the buffer
+ * @param max_elements
+ * 	The maximum number of elements that the buffer should be able to hold at once
+ * @param max_readers
+ * 	The maximum number of buffer readers that are allowed to exist in parallel
+ */
+#define CONCURRENT_MULTI_READER_BUFFER_SIZE(word_size, max_elements, max_readers) (sizeof(ConcurrentMultiReaderBuffer) + max_readers * sizeof(ConcurrentBufferReader) + max_elements * (sizeof(uint64_t) + word_size))
+
+/*!
+ * @struct ConcurrentMultiReaderBuffer
+ *
+ * @brief	Defines the structure of the concurrent buffer.
+ *
+ * The reader slots, the slot stamps and the data slots follow the struct in this order.
+ * They are located relative to the struct, so no absolute pointers are stored.
+ */
+struct ConcurrentMultiReaderBuffer
+{
+	size_t word_size_in_byte;	//!< Stores the size in byte of the individual data items stored
+	size_t max_elements;	//!< Stores the maximum number of elements, a power of two
+	size_t max_readers;	//!< Stores the maximum number of readers allowed in parallel
+	MultiReaderBufferOptions options;	//!< Stores the options the buffer has been initialized with
+	_Alignas(CONCURRENT_MULTI_READER_BUFFER_CACHE_LINE_SIZE) _Atomic uint64_t write_sequence;	//!< Number of items published by the producer so far
+	_Atomic uint32_t wake_up_counter;	//!< Futex word, incremented by the producer to wake up waiting readers
+	_Atomic uint32_t number_of_waiting_readers;	//!< Number of threads blocked in waitForItemsWithConcurrentReader
+	_Alignas(CONCURRENT_MULTI_READER_BUFFER_CACHE_LINE_SIZE) _Atomic uint64_t claim_sequence;	//!< Number of items claimed by producers so far (MULTI_READER_BUFFER_MULTIPLE_PRODUCERS only)
+};
+
+#endif
@@ -6,6 +6,19 @@
 #include <stdbool.h>
 
 #include "CException.h"
+#include "EmbeddedUtilities/Callback.h"
+
+/*!
+ * @define MULTI_READER_BUFFER_METRICS
+ * 
+ * @brief	Compile with -DMULTI_READER_BUFFER_METRICS=1 to add metric counters and their functions.
+ * 
+ * The counters change the layout of the buffer, so the flag has to be the same for all
+ * translation units using a buffer (see the MultiReaderBufferMetrics target).
+ */
+#ifndef MULTI_READER_BUFFER_METRICS
+#define MULTI_READER_BUFFER_METRICS (0)
+#endif
 
 /*!
  * @enum MultiReaderBufferExceptions
@@ -14,14 +27,37 @@
  * 
  * CException is used for an exception framework.
  */
-enum
+typedef enum
 {
 	BUFFER_UNDERRUN_EXCEPTION = 0x01,	//!< More items than existent have been tried to be read by a reader.
 	BUFFER_OVERRUN_EXCEPTION = 0x02,	//!< More items have been written than could have been read by a reader, i.e. unread items have been overwritten.
 	BUFFER_NO_FREE_READER_SLOTS_EXCEPTION = 0x03,	//!< The number of reader slots is exhausted.
-	BUFFER_INVALID_READER_EXCEPTION = 0x04	//!< It has been tried to execute an operation with an invalid reader.
+	BUFFER_INVALID_READER_EXCEPTION = 0x04,	//!< It has been tried to execute an operation with an invalid reader.
+	BUFFER_INVALID_COMMIT_EXCEPTION = 0x05,	//!< More items have been tried to be committed than have been reserved.
+	BUFFER_INVALID_CAPACITY_EXCEPTION = 0x06,	//!< The requested number of elements is not supported by the selected options.
+	BUFFER_INVALID_RECORD_LENGTH_EXCEPTION = 0x09	//!< A record is too long to be stored in a MultiReaderRecordBuffer.
 } MultiReaderBufferException;
 
+/*!
+ * @enum BufferStatus
+ * 
+ * @brief	Defines the results of buffer operations that report errors by return value instead of exceptions.
+ * 
+ * The values are identical to the corresponding exceptions above, so a status can be thrown if desired.
+ */
+typedef enum
+{
+	BUFFER_OK = 0x00,	//!< The operation succeeded.
+	BUFFER_EMPTY = 0x01,	//!< There are no items left to be read by the reader.
+	BUFFER_OVERRUN = 0x02,	//!< The reader has been overrun, i.e. items have been lost; the reader now points to the oldest item.
+	BUFFER_NO_FREE_READER_SLOTS = 0x03,	//!< The number of reader slots is exhausted.
+	BUFFER_INVALID_READER = 0x04,	//!< The reader descriptor does not belong to a valid reader.
+	BUFFER_INVALID_CAPACITY = 0x06,	//!< The requested number of elements is not supported, e.g. because it is not a power of two.
+	BUFFER_FULL = 0x07,	//!< The items have not been written, since they would overwrite unread items of a reader.
+	BUFFER_UNAVAILABLE = 0x08,	//!< A shared buffer could not be created, or there is no initialized buffer to attach to.
+	BUFFER_EVICTED = 0x0A	//!< The requested item has already been overwritten and cannot be read anymore.
+} BufferStatus;
+
 /*!
  * @enum BufferReaderState
  * 
@@ -37,23 +73,202 @@ typedef enum
 	BUFFER_READER_INVALID = 0x02	//!< A reader is invalid.
 } BufferReaderState;
 
+/*!
+ * @enum MultiReaderBufferOption
+ * 
+ * @brief	Defines the options that can be combined when initializing a buffer via initMultiReaderBufferWithOptions.
+ */
+typedef enum
+{
+	MULTI_READER_BUFFER_DEFAULT_OPTIONS = 0x00,	//!< Any capacity, reader positions are updated by the writer.
+	MULTI_READER_BUFFER_POWER_OF_TWO_CAPACITY = 0x01,	//!< Capacity must be a power of two; free-running positions, no "wasted" slot and overruns are detected by the readers.
+	MULTI_READER_BUFFER_SKIP_ZEROING = 0x02,	//!< The data slots are not cleared on init, e.g. for memory that is zeroed already (calloc, fresh mmap).
+	MULTI_READER_BUFFER_REJECT_WHEN_FULL = 0x04,	//!< Pushes that would overwrite unread items are rejected with BUFFER_FULL instead.
+	MULTI_READER_BUFFER_BLOCK_WHEN_FULL = 0x08,	//!< Pushes wait until the slowest reader has advanced (ConcurrentMultiReaderBuffer only, otherwise same as rejecting).
+	MULTI_READER_BUFFER_MULTIPLE_PRODUCERS = 0x10	//!< Several threads may push at the same time (ConcurrentMultiReaderBuffer only).
+} MultiReaderBufferOption;
+
+typedef uint8_t MultiReaderBufferOptions;	//!< Bitwise combination of MultiReaderBufferOption values
+
 typedef struct Buffer Buffer;	// Forward declaration
 typedef struct MultiReaderBuffer MultiReaderBuffer;
 
+/*!
+ * @struct BufferReader
+ * 
+ * @brief	The state of a single reader slot.
+ */
+typedef struct BufferReader
+{
+	size_t position;	//!< Position of the next item to be read, in the same representation as the write position
+	size_t lost_elements;	//!< Number of items lost by the latest overrun
+	BufferReaderState state;	//!< Current reader state (see BufferReaderState)
+	GenericCallback notification;	//!< Called once notification_threshold items are unread (see setBufferReaderNotification)
+	size_t notification_threshold;	//!< Number of unread items that triggers the notification, 0 if none is registered
+	bool notification_sent;	//!< Set when the notification has been sent, cleared when the reader reads again
+#if MULTI_READER_BUFFER_METRICS
+	uint64_t consumed_elements;	//!< Number of items read since the descriptor has been handed out
+	uint64_t dropped_elements;	//!< Number of items lost to overruns since the descriptor has been handed out
+	size_t max_lag;	//!< Largest number of unread items seen
+#endif
+} BufferReader;
+
+#if MULTI_READER_BUFFER_METRICS
+/*!
+ * @struct BufferReaderMetrics
+ * 
+ * @brief	Snapshot of the counters of a single reader (see getBufferReaderMetrics).
+ */
+typedef struct BufferReaderMetrics
+{
+	uint64_t consumed_elements;	//!< Number of items read since the descriptor has been handed out
+	uint64_t dropped_elements;	//!< Number of items lost to overruns since the descriptor has been handed out
+	size_t max_lag;	//!< Largest number of unread items the reader had
+	size_t current_lag;	//!< Number of items the reader has not read yet
+} BufferReaderMetrics;
+
+/*!
+ * @struct BufferMetrics
+ * 
+ * @brief	Snapshot of the buffer-wide counters (see getBufferMetrics).
+ */
+typedef struct BufferMetrics
+{
+	uint64_t pushed_elements;	//!< Number of items written since init
+	uint64_t rejected_elements;	//!< Number of items rejected since init (MULTI_READER_BUFFER_REJECT_WHEN_FULL)
+	size_t max_fill;	//!< Largest number of unread items any reader had, i.e. the capacity that has actually been needed
+} BufferMetrics;
+#endif
+
+/*!
+ * @struct BufferSpan
+ * 
+ * @brief	Describes the unread items of a reader as up to two contiguous memory regions.
+ * 
+ * The second region is only used if the unread items wrap around the end of the buffer memory.
+ * Lengths are given in data items, not in bytes.
+ */
+typedef struct BufferSpan
+{
+	const void *first;	//!< Points to the oldest unread item
+	size_t first_length;	//!< Number of items in the first region
+	const void *second;	//!< Points to the start of the buffer memory, where the wrapped-around items continue
+	size_t second_length;	//!< Number of items in the second region
+} BufferSpan;
+
+/*!
+ * @struct BufferSpillHandler
+ * 
+ * @brief	Takes over the items of the durable reader before they are overwritten (see setBufferSpillHandler).
+ */
+typedef struct BufferSpillHandler
+{
+	void (*function)(void *argument, const void *items, size_t count);	//!< Called with count consecutive items, oldest first
+	void *argument;	//!< Passed to the function unchanged
+} BufferSpillHandler;
+
 /*!
  * @brief	Writes new data into the buffer.
  * 
  * As with the nature of a circular buffer, the buffer space virtually never "ends"
  * since when space is used up the buffer is written from the start again, overwriting the oldest entries.
+ * If the buffer has been initialized with MULTI_READER_BUFFER_REJECT_WHEN_FULL, the item is
+ * dropped instead whenever it would overwrite an item that an active reader has not read yet.
  * 
  * @param self
  * 	A pointer to the circular buffer, addressed by its generalized type
  * @param data
  * 	The data that should be written into the buffer
+ * 
+ * @returns
+ * 	BUFFER_OK, or BUFFER_FULL if the item has been rejected
  */
-void 
+BufferStatus
 pushToBuffer(Buffer *self, const void *data);
 
+/*!
+ * @brief	Writes a burst of data items into the buffer at once.
+ * 
+ * The result is the same as calling pushToBuffer once for every item, but the items are
+ * copied in at most two contiguous chunks (before and after the wrap-around) and the reader
+ * positions are updated only once for the whole burst.
+ * If more than max_elements items are pushed, only the last max_elements items are kept.
+ * When rejecting while full, either the whole burst is written or none of it.
+ * 
+ * @param self
+ * 	A pointer to the circular buffer, addressed by its generalized type
+ * @param data
+ * 	Pointer to count data items of the buffer's word size, stored back to back
+ * @param count
+ * 	The number of data items that should be written into the buffer
+ * 
+ * @returns
+ * 	BUFFER_OK, or BUFFER_FULL if the burst has been rejected
+ */
+BufferStatus
+pushManyToBuffer(Buffer *self, const void *data, size_t count);
+
+/*!
+ * @brief	Returns how many items can be pushed before the slowest active reader would lose data.
+ * 
+ * Producers can use this to adapt the size of their bursts. Without active readers
+ * the whole capacity is free.
+ * 
+ * @param self
+ * 	A pointer to the circular buffer, addressed by its generalized type
+ * 
+ * @returns
+ * 	max_elements minus the number of unread items of the slowest active reader
+ */
+size_t
+getFreeSpaceOfBuffer(const Buffer *self);
+
+/*!
+ * @brief	Reserves space for writing data items directly into the buffer memory.
+ * 
+ * Returns a pointer to the slot the next pushed item would be written to. The reserved_elements
+ * slots starting there are contiguous in memory and can be filled in place, e.g. by DMA,
+ * before publishing them with commitBufferSpace. Readers do not see the reserved items until
+ * they have been committed.
+ * Fewer slots than requested are reserved if the request exceeds max_elements or the
+ * remaining space until the wrap-around of the buffer memory, or, when rejecting while full,
+ * the free space (see getFreeSpaceOfBuffer).
+ * 
+ * Readers whose unread items would be overwritten by the reserved slots are treated
+ * as overrun already when reserving, or with power-of-two capacity on their next read
+ * while the reservation is open. No other items must be pushed before the reservation
+ * has been committed.
+ * 
+ * @param self
+ * 	A pointer to the circular buffer, addressed by its generalized type
+ * @param requested_elements
+ * 	The number of data items that should be reserved
+ * @param reserved_elements
+ * 	Returns the number of data items that have actually been reserved
+ * 
+ * @returns
+ * 	A pointer to the first reserved slot
+ */
+void*
+reserveBufferSpace(Buffer *self, size_t requested_elements, size_t *reserved_elements);
+
+/*!
+ * @brief	Publishes data items that have been written into space obtained from reserveBufferSpace.
+ * 
+ * The number of committed items may be smaller than the number of reserved items.
+ * The reservation ends with this call in any case.
+ * 
+ * @param self
+ * 	A pointer to the circular buffer, addressed by its generalized type
+ * @param number_of_elements
+ * 	The number of data items that have been written, starting at the first reserved slot
+ * 
+ * @throws BUFFER_INVALID_COMMIT_EXCEPTION
+ * 	An exception is thrown if more items are committed than have been reserved
+ */
+void
+commitBufferSpace(Buffer *self, size_t number_of_elements);
+
 /*!
  * @brief	 Returns a descriptor for a new buffer reader.
  * 
@@ -165,6 +380,301 @@ popFromBufferWithReader(Buffer *self, uint8_t reader_descriptor);
 const void* 
 peekAtBufferWithReader(const Buffer *self, uint8_t reader_descriptor);
 
+/*!
+ * @brief	Same as popFromBufferWithReader, but reports errors by return value instead of exceptions.
+ * 
+ * Meant for polling consumers, for which an empty buffer is the normal case
+ * and a CException Try frame per poll would be too expensive.
+ * If the reader has been overrun, it is repositioned to the oldest entry just like with
+ * popFromBufferWithReader, but no item is returned.
+ * 
+ * @param self
+ * 	A pointer to the circular buffer, addressed by its generalized type
+ * @param reader_descriptor
+ * 	The descriptor of the reader with which the data should be retrieved
+ * @param item
+ * 	Returns an "untyped" pointer to the element that has been read, only set if BUFFER_OK is returned
+ * 
+ * @returns
+ * 	BUFFER_OK, BUFFER_EMPTY, BUFFER_OVERRUN or BUFFER_INVALID_READER
+ */
+BufferStatus
+tryPopFromBufferWithReader(Buffer *self, uint8_t reader_descriptor, const void **item);
+
+/*!
+ * @brief	Same as peekAtBufferWithReader, but reports errors by return value instead of exceptions.
+ * 
+ * @param self
+ * 	A pointer to the circular buffer, addressed by its generalized type
+ * @param reader_descriptor
+ * 	The descriptor of the reader with which the data should be retrieved
+ * @param item
+ * 	Returns an "untyped" pointer to the element the reader is positioned at, only set if BUFFER_OK is returned
+ * 
+ * @returns
+ * 	BUFFER_OK, BUFFER_EMPTY, BUFFER_OVERRUN or BUFFER_INVALID_READER
+ */
+BufferStatus
+tryPeekAtBufferWithReader(const Buffer *self, uint8_t reader_descriptor, const void **item);
+
+/*!
+ * @brief	Returns all items that have not been read by a reader yet, without "removing" them.
+ * 
+ * The items are described by up to two contiguous memory regions (see BufferSpan), so they
+ * can be processed in bulk. Use consumeWithReader afterwards to advance the reader.
+ * In contrast to peekAtBufferWithReader, no exception is thrown if there is nothing to read;
+ * an empty span is returned instead.
+ * 
+ * If the reader pointer has been overrun by the write pointer, the reader pointer will be
+ * repositioned to the oldest entry in the buffer before an exception will be thrown.
+ * 
+ * @param self
+ * 	A pointer to the circular buffer, addressed by its generalized type
+ * @param reader_descriptor
+ * 	The descriptor of the reader with which the data should be retrieved
+ * @param span
+ * 	Returns the memory regions holding the unread items
+ * 
+ * @returns
+ * 	The total number of unread items
+ * 
+ * @throws BUFFER_INVALID_READER_EXCEPTION
+ * 	An exception is thrown if the reader descriptor is invalid
+ * @throws BUFFER_OVERRUN_EXCEPTION
+ * 	An exception is thrown if the reader has been overrun by the write pointer,
+ * 	i.e. elements have been lost
+ */
+size_t
+peekSpanWithReader(const Buffer *self, uint8_t reader_descriptor, BufferSpan *span);
+
+/*!
+ * @brief	Advances a reader by several items at once.
+ * 
+ * Usually called after processing the items obtained via peekSpanWithReader.
+ * 
+ * @param self
+ * 	A pointer to the circular buffer, addressed by its generalized type
+ * @param reader_descriptor
+ * 	The descriptor of the reader that should be advanced
+ * @param number_of_elements
+ * 	The number of items that have been read
+ * 
+ * @throws BUFFER_INVALID_READER_EXCEPTION
+ * 	An exception is thrown if the reader descriptor is invalid
+ * @throws BUFFER_OVERRUN_EXCEPTION
+ * 	An exception is thrown if the reader has been overrun since the items have been peeked,
+ * 	i.e. they might have been overwritten; the reader is repositioned to the oldest entry
+ * @throws BUFFER_UNDERRUN_EXCEPTION
+ * 	An exception is thrown if more items are consumed than there are unread items
+ */
+void
+consumeWithReader(Buffer *self, uint8_t reader_descriptor, size_t number_of_elements);
+
+/*!
+ * @brief	Returns how many items a reader has lost with its latest overrun.
+ * 
+ * The count refers to the overrun that has been reported last (or is about to be reported)
+ * by a BUFFER_OVERRUN_EXCEPTION and is reset when the descriptor is handed out again.
+ * With MULTI_READER_BUFFER_POWER_OF_TWO_CAPACITY the count is exact even if the reader has
+ * been lapped several times, since positions are free-running counters.
+ * 
+ * @param self
+ * 	A pointer to the circular buffer, addressed by its generalized type
+ * @param reader_descriptor
+ * 	The descriptor of the reader
+ * 
+ * @returns
+ * 	The number of items that have been overwritten before the reader could read them
+ * 
+ * @throws BUFFER_INVALID_READER_EXCEPTION
+ * 	An exception is thrown if the descriptor does not correspond to an actual reader slot
+ */
+size_t
+getNumberOfLostElementsForReader(const Buffer *self, uint8_t reader_descriptor);
+
+/*!
+ * @brief	Returns the sequence number the next pushed item will get.
+ * 
+ * Every pushed item gets a sequence number, counting from 0 since the buffer has been initialized.
+ * Rejected items do not consume a sequence number.
+ * 
+ * @param self
+ * 	A pointer to the circular buffer, addressed by its generalized type
+ * 
+ * @returns
+ * 	The number of items pushed since init
+ */
+uint64_t
+getNextBufferSequenceNumber(const Buffer *self);
+
+/*!
+ * @brief	Returns the sequence number of the item a reader reads next.
+ * 
+ * If the reader has been overrun and not been told so yet, this is the sequence number of its first lost item.
+ * 
+ * @param self
+ * 	A pointer to the circular buffer, addressed by its generalized type
+ * @param reader_descriptor
+ * 	The descriptor of the reader
+ * 
+ * @returns
+ * 	The sequence number, equal to getNextBufferSequenceNumber if the reader has read everything
+ * 
+ * @throws BUFFER_INVALID_READER_EXCEPTION
+ * 	An exception is thrown if the reader descriptor is invalid
+ */
+uint64_t
+getBufferReaderSequenceNumber(const Buffer *self, uint8_t reader_descriptor);
+
+/*!
+ * @brief	Moves a reader to the item with the given sequence number in constant time.
+ * 
+ * Lets a consumer resume after the last item it has processed, e.g. a client reconnecting with
+ * the sequence number of its last acknowledged item plus one. Seeking clears a pending overrun.
+ * If the function fails, the reader is not moved.
+ * 
+ * @param self
+ * 	A pointer to the circular buffer, addressed by its generalized type
+ * @param reader_descriptor
+ * 	The descriptor of the reader
+ * @param sequence_number
+ * 	The sequence number of the item the reader should read next
+ * 
+ * @returns
+ * 	BUFFER_OK if the reader has been moved;
+ * 	BUFFER_EVICTED if the item has already been overwritten (see seekBufferReaderToOldest);
+ * 	BUFFER_EMPTY if no item with this sequence number has been pushed so far;
+ * 	BUFFER_INVALID_READER if the reader descriptor is invalid
+ */
+BufferStatus
+seekBufferReaderToSequenceNumber(Buffer *self, uint8_t reader_descriptor, uint64_t sequence_number);
+
+/*!
+ * @brief	Moves a reader to the oldest item still held by the buffer.
+ * 
+ * @param self
+ * 	A pointer to the circular buffer, addressed by its generalized type
+ * @param reader_descriptor
+ * 	The descriptor of the reader
+ * 
+ * @returns
+ * 	The sequence number of the item the reader reads next
+ * 
+ * @throws BUFFER_INVALID_READER_EXCEPTION
+ * 	An exception is thrown if the reader descriptor is invalid
+ */
+uint64_t
+seekBufferReaderToOldest(Buffer *self, uint8_t reader_descriptor);
+
+/*!
+ * @brief	Moves a reader to the most recently pushed item, so it skips all older items.
+ * 
+ * @param self
+ * 	A pointer to the circular buffer, addressed by its generalized type
+ * @param reader_descriptor
+ * 	The descriptor of the reader
+ * 
+ * @returns
+ * 	The sequence number of the item the reader reads next
+ * 
+ * @throws BUFFER_INVALID_READER_EXCEPTION
+ * 	An exception is thrown if the reader descriptor is invalid
+ */
+uint64_t
+seekBufferReaderToNewest(Buffer *self, uint8_t reader_descriptor);
+
+/*!
+ * @brief	Designates a durable reader whose unread items are handed to a handler instead of being overwritten.
+ * 
+ * Whenever a push would overwrite items the durable reader has not read yet, the oldest of them
+ * are passed to the handler and the reader is moved past them, so it never experiences an overrun.
+ * The handler is expected to store the items elsewhere, e.g. in a file (see BufferSpillFile),
+ * from where the reader drains them before it continues with the buffer.
+ * To save calls, at least batch_size items are handed over at once if the reader has that many unread.
+ * A buffer has at most one durable reader; the handler is removed when its descriptor is deleted.
+ * Pushes only pay a single comparison as long as no durable reader is set.
+ * 
+ * The handler is called from within the push functions and must not push to the buffer itself.
+ * Buffers initialized with MULTI_READER_BUFFER_REJECT_WHEN_FULL never overwrite unread items,
+ * so the handler is not called for them.
+ * 
+ * @param self
+ * 	A pointer to the circular buffer, addressed by its generalized type
+ * @param reader_descriptor
+ * 	The descriptor of the durable reader
+ * @param handler
+ * 	The function taking over the items; a NULL function removes the durable reader
+ * @param batch_size
+ * 	The preferred number of items per call, at most max_elements
+ * 
+ * @throws BUFFER_INVALID_READER_EXCEPTION
+ * 	An exception is thrown if the reader descriptor is invalid
+ */
+void
+setBufferSpillHandler(Buffer *self, uint8_t reader_descriptor, BufferSpillHandler handler, size_t batch_size);
+
+/*!
+ * @brief	Registers a callback that tells a reader when items are waiting for it.
+ * 
+ * The callback is invoked from within the push functions (pushToBuffer, pushManyToBuffer,
+ * commitBufferSpace) as soon as the reader has at least threshold unread items.
+ * Notifications are coalesced: after the callback has been invoked, it is not invoked again
+ * before the reader has read something, no matter how many items are pushed in the meantime.
+ * So a consumer should read until the buffer is empty once it has been notified.
+ * 
+ * The callback is invoked after the items have been written, so it may read from the buffer.
+ * Pushes of buffers without notifications do not pay for this feature.
+ * 
+ * @param self
+ * 	A pointer to the circular buffer, addressed by its generalized type
+ * @param reader_descriptor
+ * 	The descriptor of the reader
+ * @param callback
+ * 	The function to be called and its argument
+ * @param threshold
+ * 	The number of unread items that triggers the callback; 0 removes the notification,
+ * 	values larger than max_elements are treated as max_elements
+ * 
+ * @throws BUFFER_INVALID_READER_EXCEPTION
+ * 	An exception is thrown if the reader descriptor is invalid
+ */
+void
+setBufferReaderNotification(Buffer *self, uint8_t reader_descriptor, GenericCallback callback, size_t threshold);
+
+#if MULTI_READER_BUFFER_METRICS
+/*!
+ * @brief	Returns a snapshot of the buffer-wide counters.
+ * 
+ * Counting costs a few additions per operation. The maximum lag of a reader is sampled
+ * whenever it reads, since that is when the lag is largest.
+ * 
+ * @param self
+ * 	A pointer to the circular buffer, addressed by its generalized type
+ * @param metrics
+ * 	Returns the counters
+ */
+void
+getBufferMetrics(const Buffer *self, BufferMetrics *metrics);
+
+/*!
+ * @brief	Returns a snapshot of the counters of a reader.
+ * 
+ * The counters are reset when the descriptor is handed out by getNewBufferReaderDescriptor.
+ * 
+ * @param self
+ * 	A pointer to the circular buffer, addressed by its generalized type
+ * @param reader_descriptor
+ * 	The descriptor of the reader
+ * @param metrics
+ * 	Returns the counters
+ * 
+ * @throws BUFFER_INVALID_READER_EXCEPTION
+ * 	An exception is thrown if the reader descriptor is invalid
+ */
+void
+getBufferReaderMetrics(const Buffer *self, uint8_t reader_descriptor, BufferReaderMetrics *metrics);
+#endif
+
 /*!
  * @brief	Initializes a multi reader buffer.
  * 
@@ -187,7 +697,32 @@ peekAtBufferWithReader(const Buffer *self, uint8_t reader_descriptor);
  * 	The maximum number of buffer readers that are allowed to exist in parallel
  */
 void 
-initMultiReaderBuffer(MultiReaderBuffer *self, uint8_t word_size, size_t max_elements, size_t max_readers);
+initMultiReaderBuffer(MultiReaderBuffer *self, size_t word_size, size_t max_elements, size_t max_readers);
+
+/*!
+ * @brief	Initializes a multi reader buffer with a set of options.
+ * 
+ * Same as initMultiReaderBuffer, but allows to select options (see MultiReaderBufferOption).
+ * With MULTI_READER_BUFFER_POWER_OF_TWO_CAPACITY slot indexes are computed by masking
+ * free-running positions, so pushToBuffer never has to touch the readers and all
+ * max_elements slots of the memory are used.
+ * 
+ * @param self
+ * 	Pointer to the memory that should be used for the circular buffer
+ * @param word_size
+ * 	The size in byte of the individual data items that should be managed in the buffer
+ * @param max_elements
+ * 	The maximum number of elements that the buffer should be able to hold at once
+ * @param max_readers
+ * 	The maximum number of buffer readers that are allowed to exist in parallel
+ * @param options
+ * 	Bitwise combination of MultiReaderBufferOption values
+ * 
+ * @throws BUFFER_INVALID_CAPACITY_EXCEPTION
+ * 	An exception is thrown if max_elements does not fit the options, e.g. is no power of two
+ */
+void
+initMultiReaderBufferWithOptions(MultiReaderBuffer *self, size_t word_size, size_t max_elements, size_t max_readers, MultiReaderBufferOptions options);
 
 /*!
  * @define MULTI_READER_BUFFER_SIZE
@@ -195,7 +730,8 @@ initMultiReaderBuffer(MultiReaderBuffer *self, uint8_t word_size, size_t max_ele
  * @brief	Expands to the number of bytes required to create a circular buffer with the provided parameters.
  * 
  * This macro should be used to obtain the correct number of bytes to be allocated for creating a circular buffer.
- * One buffer position is "wasted" for distinguishing whether the buffer is full or empty.
+ * One buffer position is "wasted" for distinguishing whether the buffer is full or empty
+ * (it is left unused with MULTI_READER_BUFFER_POWER_OF_TWO_CAPACITY).
  * 
  * @param word_size
  * 	The size in byte of the individual data items that should be managed in the buffer
@@ -204,7 +740,7 @@ initMultiReaderBuffer(MultiReaderBuffer *self, uint8_t word_size, size_t max_ele
  * @param max_readers
  * 	The maximum number of buffer readers that are allowed to exist in parallel
  */
-#define MULTI_READER_BUFFER_SIZE(word_size, max_elements, max_readers) (sizeof(MultiReaderBuffer) + word_size * (max_elements + 1) + max_readers * (sizeof(void*) + sizeof(BufferReaderState)))
+#define MULTI_READER_BUFFER_SIZE(word_size, max_elements, max_readers) (sizeof(MultiReaderBuffer) + word_size * (max_elements + 1) + max_readers * sizeof(BufferReader) + (max_readers + 7) / 8)
 
 /*!
  * @struct MultiReaderBuffer
@@ -215,16 +751,34 @@ initMultiReaderBuffer(MultiReaderBuffer *self, uint8_t word_size, size_t max_ele
  * to provide a mechanism for implementing 1-to-n producer-consumer relationships
  * in an efficient manner as often needed in the realm of embedded systems.
  * It is utilized as part of the data processing pipeline implemented by the edge device.
+ * 
+ * The reader slots, the buffer memory and a bitmap of the reader slots in use follow the struct
+ * in this order. They are located relative to the struct and positions are stored as indexes,
+ * so the buffer contains no absolute pointers and can be placed in memory shared between processes
+ * (except for the callbacks registered via setBufferReaderNotification and setBufferSpillHandler).
  */
 struct MultiReaderBuffer
 {
-	uint8_t word_size_in_byte;	//!< Stores the size in byte of the individual data items stored
+	size_t word_size_in_byte;	//!< Stores the size in byte of the individual data items stored
 	size_t max_elements;	//!< Stores the maximum number of elements
 	size_t max_readers;	//!< Stores the maximum number of readers allowed in parallel
-	void *start;	//!< Stores the pointer to the start position of the buffer
-	void *write;	//!< Stores the writer pointer, which always points to the next position it would write to
-	void **readers;	//!< Holds the array of readers, where each reader is represented by a pointer into the buffer memory
-	BufferReaderState *reader_state_indicators;	//!< For each reader slot this array stores the current reader state (see BufferReaderState)
+	MultiReaderBufferOptions options;	//!< Stores the options the buffer has been initialized with
+	size_t number_of_slots;	//!< Stores the number of slots used in the buffer memory
+	size_t stored_elements;	//!< Stores the number of items currently held, at most max_elements
+	size_t write;	//!< Stores the write position, which always refers to the next slot it would write to (free-running with power-of-two capacity)
+	size_t reserved_elements;	//!< Stores the number of slots reserved via reserveBufferSpace that have not been committed yet
+	size_t number_of_active_readers;	//!< Stores the number of reader slots in use
+	size_t slowest_reader_position;	//!< Caches the position of the reader lagging behind most; may be outdated, but never lags less than any active reader
+	size_t number_of_notified_readers;	//!< Stores the number of active readers with a notification registered
+	uint64_t next_sequence_number;	//!< Stores the sequence number of the next pushed item, i.e. the number of items pushed since init
+	size_t durable_reader;	//!< Stores the descriptor of the reader whose items are spilled instead of overwritten, max_readers if there is none
+	BufferSpillHandler spill_handler;	//!< Takes over the items of the durable reader (see setBufferSpillHandler)
+	size_t spill_batch_size;	//!< Stores the preferred number of items per spill handler call
+#if MULTI_READER_BUFFER_METRICS
+	uint64_t pushed_elements;	//!< Number of items written since init
+	uint64_t rejected_elements;	//!< Number of items rejected since init
+	size_t max_fill;	//!< Largest number of unread items any reader had
+#endif
 };
 
 #endif
@@ -0,0 +1,252 @@
+#ifndef MULTI_READER_RECORD_BUFFER_H
+#define MULTI_READER_RECORD_BUFFER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "EmbeddedUtilities/MultiReaderBuffer.h"
+
+/**
+ * \file EmbeddedUtilities/MultiReaderRecordBuffer.h
+ *
+ * A variant of the MultiReaderBuffer for records of varying length, e.g. messages or frames.
+ * Records are stored back to back, each preceded by its length. A record is never split
+ * at the end of the buffer memory: if it does not fit anymore, a wrap marker is left behind
+ * and the record is stored at the start of the memory instead.
+ *
+ * Readers behave like the readers of the MultiReaderBuffer. When space is needed, the oldest
+ * records are overwritten and readers that have not read them yet are overrun.
+ */
+
+/*!
+ * @define MULTI_READER_RECORD_BUFFER_HEADER_SIZE
+ *
+ * @brief	The number of bytes stored in front of each record.
+ */
+#define MULTI_READER_RECORD_BUFFER_HEADER_SIZE (sizeof(uint16_t))
+
+/*!
+ * @define MULTI_READER_RECORD_BUFFER_MAX_RECORD_LENGTH
+ *
+ * @brief	Expands to the maximum length of a single record for a buffer of the given capacity.
+ *
+ * A record including its header may take at most half of the buffer memory, so it always fits
+ * behind a wrap marker. Independent of the capacity, records are limited to 65534 bytes.
+ *
+ * @param max_bytes
+ * 	The capacity of the buffer memory in byte
+ */
+#define MULTI_READER_RECORD_BUFFER_MAX_RECORD_LENGTH(max_bytes) ((max_bytes) / 2 - MULTI_READER_RECORD_BUFFER_HEADER_SIZE)
+
+typedef struct MultiReaderRecordBuffer MultiReaderRecordBuffer;
+
+/*!
+ * @struct RecordBufferReader
+ *
+ * @brief	The state of a single reader slot.
+ */
+typedef struct RecordBufferReader
+{
+	size_t position;	//!< Free-running byte position of the next record to be read
+	size_t record;	//!< Number of the next record to be read, used to count lost records
+	size_t lost_records;	//!< Number of records lost by the latest overrun
+	BufferReaderState state;	//!< Current reader state (see BufferReaderState)
+} RecordBufferReader;
+
+/*!
+ * @brief	Initializes a multi reader record buffer.
+ *
+ * The memory should be created using MULTI_READER_RECORD_BUFFER_SIZE with the same set of parameters.
+ *
+ * @param self
+ * 	Pointer to the memory that should be used for the buffer
+ * @param max_bytes
+ * 	The capacity of the buffer memory in byte, including the record headers; must be a power of two
+ * @param max_readers
+ * 	The maximum number of buffer readers that are allowed to exist in parallel
+ *
+ * @throws BUFFER_INVALID_CAPACITY_EXCEPTION
+ * 	An exception is thrown if max_bytes is no power of two
+ */
+void
+initMultiReaderRecordBuffer(MultiReaderRecordBuffer *self, size_t max_bytes, size_t max_readers);
+
+/*!
+ * @brief	Writes a record into the buffer.
+ *
+ * As many of the oldest records are overwritten as needed to make room for the new one.
+ *
+ * @param self
+ * 	A pointer to the buffer
+ * @param data
+ * 	The record that should be written into the buffer
+ * @param length
+ * 	The length of the record in byte
+ *
+ * @throws BUFFER_INVALID_RECORD_LENGTH_EXCEPTION
+ * 	An exception is thrown if length exceeds MULTI_READER_RECORD_BUFFER_MAX_RECORD_LENGTH
+ */
+void
+pushRecord(MultiReaderRecordBuffer *self, const void *data, size_t length);
+
+/*!
+ * @brief	Returns a descriptor for a new reader, which starts at the oldest record.
+ *
+ * @param self
+ * 	A pointer to the buffer
+ *
+ * @returns
+ * 	A descriptor for the newly allocated reader
+ *
+ * @throws BUFFER_NO_FREE_READER_SLOTS_EXCEPTION
+ * 	An exception is thrown when all reader slots are in use
+ */
+uint8_t
+getNewRecordBufferReaderDescriptor(MultiReaderRecordBuffer *self);
+
+/*!
+ * @brief	Flags the provided reader descriptor as invalid.
+ *
+ * @param self
+ * 	A pointer to the buffer
+ * @param reader_descriptor
+ * 	The descriptor of the reader
+ *
+ * @throws BUFFER_INVALID_READER_EXCEPTION
+ * 	An exception is thrown if the descriptor does not correspond to an actual reader slot
+ */
+void
+deleteRecordBufferReaderDescriptor(MultiReaderRecordBuffer *self, uint8_t reader_descriptor);
+
+/*!
+ * @brief	Returns whether there is at least one unread record left for the reader.
+ *
+ * @param self
+ * 	A pointer to the buffer
+ * @param reader_descriptor
+ * 	The descriptor of the reader
+ *
+ * @returns
+ * 	true if the reader descriptor is valid and there are still records left to be read
+ */
+bool
+readableRecordExistsForReader(const MultiReaderRecordBuffer *self, uint8_t reader_descriptor);
+
+/*!
+ * @brief	Reads the oldest unread record of a reader without "removing" it.
+ *
+ * The record is returned by reference and stored contiguously. It is not aligned in any way.
+ *
+ * @param self
+ * 	A pointer to the buffer
+ * @param reader_descriptor
+ * 	The descriptor of the reader
+ * @param length
+ * 	Returns the length of the record in byte
+ *
+ * @returns
+ * 	A pointer to the record
+ *
+ * @throws BUFFER_INVALID_READER_EXCEPTION
+ * 	An exception is thrown if the reader descriptor is invalid
+ * @throws BUFFER_OVERRUN_EXCEPTION
+ * 	An exception is thrown if records have been overwritten before the reader could read them;
+ * 	the reader is repositioned to the oldest record
+ * @throws BUFFER_UNDERRUN_EXCEPTION
+ * 	An exception is thrown if there are no records left to be read for this reader
+ */
+const void*
+peekRecordWithReader(MultiReaderRecordBuffer *self, uint8_t reader_descriptor, size_t *length);
+
+/*!
+ * @brief	Reads the oldest unread record of a reader and advances the reader.
+ *
+ * Same as peekRecordWithReader, but the reader proceeds to the next record.
+ *
+ * @param self
+ * 	A pointer to the buffer
+ * @param reader_descriptor
+ * 	The descriptor of the reader
+ * @param length
+ * 	Returns the length of the record in byte
+ *
+ * @returns
+ * 	A pointer to the record
+ *
+ * @throws BUFFER_INVALID_READER_EXCEPTION
+ * 	An exception is thrown if the reader descriptor is invalid
+ * @throws BUFFER_OVERRUN_EXCEPTION
+ * 	An exception is thrown if records have been overwritten before the reader could read them;
+ * 	the reader is repositioned to the oldest record
+ * @throws BUFFER_UNDERRUN_EXCEPTION
+ * 	An exception is thrown if there are no records left to be read for this reader
+ */
+const void*
+popRecordWithReader(MultiReaderRecordBuffer *self, uint8_t reader_descriptor, size_t *length);
+
+/*!
+ * @brief	Same as popRecordWithReader, but reports errors by return value instead of exceptions.
+ *
+ * @param self
+ * 	A pointer to the buffer
+ * @param reader_descriptor
+ * 	The descriptor of the reader
+ * @param record
+ * 	Returns a pointer to the record, only set if BUFFER_OK is returned
+ * @param length
+ * 	Returns the length of the record in byte, only set if BUFFER_OK is returned
+ *
+ * @returns
+ * 	BUFFER_OK, BUFFER_EMPTY, BUFFER_OVERRUN or BUFFER_INVALID_READER
+ */
+BufferStatus
+tryPopRecordWithReader(MultiReaderRecordBuffer *self, uint8_t reader_descriptor, const void **record, size_t *length);
+
+/*!
+ * @brief	Returns how many records a reader has lost with its latest overrun.
+ *
+ * @param self
+ * 	A pointer to the buffer
+ * @param reader_descriptor
+ * 	The descriptor of the reader
+ *
+ * @returns
+ * 	The number of records that have been overwritten before the reader could read them
+ *
+ * @throws BUFFER_INVALID_READER_EXCEPTION
+ * 	An exception is thrown if the descriptor does not correspond to an actual reader slot
+ */
+size_t
+getNumberOfLostRecordsForReader(const MultiReaderRecordBuffer *self, uint8_t reader_descriptor);
+
+/*!
+ * @define MULTI_READER_RECORD_BUFFER_SIZE
+ *
+ * @brief	Expands to the number of bytes required to create a record buffer with the provided parameters.
+ *
+ * @param max_bytes
+ * 	The capacity of the buffer memory in byte, including the record headers
+ * @param max_readers
+ * 	The maximum number of buffer readers that are allowed to exist in parallel
+ */
+#define MULTI_READER_RECORD_BUFFER_SIZE(max_bytes, max_readers) (sizeof(MultiReaderRecordBuffer) + max_readers * sizeof(RecordBufferReader) + max_bytes)
+
+/*!
+ * @struct MultiReaderRecordBuffer
+ *
+ * @brief	Defines the structure of the record buffer.
+ *
+ * The reader slots and the buffer memory follow the struct in this order.
+ * Positions are free-running byte counters, masked to obtain offsets into the buffer memory.
+ */
+struct MultiReaderRecordBuffer
+{
+	size_t max_bytes;	//!< Stores the capacity of the buffer memory in byte, a power of two
+	size_t max_readers;	//!< Stores the maximum number of readers allowed in parallel
+	size_t write;	//!< Stores the position the next record will be written to
+	size_t oldest;	//!< Stores the position of the oldest record that has not been overwritten
+	size_t oldest_record;	//!< Stores the number of the oldest record that has not been overwritten
+};
+
+#endif
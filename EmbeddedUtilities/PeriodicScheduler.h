@@ -21,9 +21,9 @@
  * and
  * ```c
  * void
- * updateScheduledTasks(PeriodicScheduler *self)
+ * updateScheduledTasks(PeriodicScheduler *self, Ticks number_of_ticks)
  * {
- *  // update period in ticks elapsed for all tasks
+ *  // advance the scheduler's tick counter
  * }
  * ```
  * then from main program call processTasks(Tasks *tasks)
@@ -45,13 +45,17 @@
  *
  * Most important the PeriodicScheduler is not coupled
  * to any clock by design. Instead it counts ticks.
- * The Scheduler will let all added tasks age by the specified number of ticks
- * for each call to updateScheduledTasks(). A call to
- * processScheduledTasks() will then go through all tasks
- * and execute each of them whose elapsed time is bigger
- * than the specified period.
+ * The Scheduler keeps a single monotonic tick counter, which is advanced
+ * by the specified number of ticks for each call to updateScheduledTasks(),
+ * so the interrupt does the same small amount of work no matter how many
+ * tasks there are. Each task stores the absolute tick count at which it is
+ * due next. A call to processScheduledTasks() will then execute each task
+ * whose deadline has been reached. The comparison is wrap-safe, the counter
+ * may overflow. The tasks are kept in a binary min-heap ordered by their
+ * deadlines, so a pass only touches the tasks that are due and stops at the
+ * first one that is not, instead of checking every slot.
  *
- * After execution the elapsed time is reset.
+ * After execution the next deadline is set one period ahead.
  * This means that tasks are not executed
  * at the point in time where the timer interrupt is issued,
  * but just on the next time the processScheduledTasks() function
@@ -71,6 +75,16 @@
  *
  */
 
+/**
+ * Compile with -DPERIODIC_SCHEDULER_PROFILING=1 to record the
+ * execution times, release jitter and deadline overruns of
+ * each task (see getTaskProfile()). When disabled, which is the
+ * default, the profiling code and data are removed completely.
+ */
+#ifndef PERIODIC_SCHEDULER_PROFILING
+#define PERIODIC_SCHEDULER_PROFILING (0)
+#endif
+
 typedef enum PeriodicSchedulerExceptions
 {
   PERIODIC_SCHEDULER_FULL_EXCEPTION = 0x01,
@@ -79,6 +93,66 @@ typedef enum PeriodicSchedulerExceptions
 
 typedef uint16_t Ticks;
 
+/**
+ * Defines when the next period of a task starts (see setTaskTiming()).
+ *
+ * With PERIODIC_SCHEDULER_FIXED_DELAY, the default, the next period
+ * starts with the execution, so any lateness of processScheduledTasks()
+ * adds up: a task with a period of 10 ticks executed 3 ticks late
+ * is executed again 10 ticks later, i.e. 13 ticks after its deadline.
+ *
+ * The fixed rate timings advance the deadline by exactly one period,
+ * so the long-term rate is exact. They differ in how instances are
+ * handled that have been missed, because their successor became due
+ * before they were executed:
+ *  - RUN_ALL executes every missed instance, in a burst
+ *  - COALESCE executes all missed instances as a single one
+ *  - SKIP drops the missed instances including the current one, the
+ *    task is executed again at the next deadline that has not passed
+ * An instance that is late by less than a period is executed by all of them.
+ */
+typedef enum TaskTiming
+{
+  PERIODIC_SCHEDULER_FIXED_DELAY = 0x00,
+  PERIODIC_SCHEDULER_FIXED_RATE_RUN_ALL,
+  PERIODIC_SCHEDULER_FIXED_RATE_COALESCE,
+  PERIODIC_SCHEDULER_FIXED_RATE_SKIP,
+} TaskTiming;
+
+/**
+ * The scheduler's tick counter and the deadlines of the tasks.
+ * It is wider than Ticks, so deadlines can be compared wrap-safely
+ * for every possible period.
+ */
+typedef uint32_t TickCount;
+
+/**
+ * Returned by getTicksUntilNextDueTask() if the
+ * schedule is empty.
+ */
+#define PERIODIC_SCHEDULER_NO_TASK_DUE (UINT32_MAX)
+
+/**
+ * Compile with -DPERIODIC_SCHEDULER_WIDE_TASK_IDS=1 to
+ * manage more than 255 tasks with a single scheduler.
+ */
+#ifndef PERIODIC_SCHEDULER_WIDE_TASK_IDS
+#define PERIODIC_SCHEDULER_WIDE_TASK_IDS 0
+#endif
+
+#if PERIODIC_SCHEDULER_WIDE_TASK_IDS
+typedef uint16_t TaskId;
+#else
+typedef uint8_t TaskId;
+#endif
+
+/**
+ * ticks_elapsed is ignored when adding a task. It is
+ * derived from the task's deadline and refreshed by
+ * getScheduledTaskById(). Do not change the period of a
+ * task that has been added, remove and add it again instead.
+ * A period of 0 is handled like a period of 1.
+ */
 typedef struct Task
 {
   void (*function)(void *argument);
@@ -99,26 +173,136 @@ typedef struct PeriodicScheduler PeriodicScheduler;
  * Execute every task in the scheduler for which
  * the configured time period has passed. After
  * execution the period restarts.
+ * Tasks that are due at the same time are executed
+ * in no particular order.
  */
 void
 processScheduledTasks(PeriodicScheduler *self);
 
 /**
  * Call this from your timer interrupt service routine.
- * It updates all tasks in the Scheduler to reflect
- * the ticks passed.
- * This advances each tasks elapsed ticks by number_of_ticks.
+ * It advances the scheduler's tick counter by number_of_ticks,
+ * which takes constant time independent of the number of tasks.
  */
 void
 updateScheduledTasks(PeriodicScheduler *self,
                      Ticks number_of_elapsed_ticks);
 
+/**
+ * Returns the number of ticks until the next task is due,
+ * 0 if a task is due already, or PERIODIC_SCHEDULER_NO_TASK_DUE
+ * if there are no tasks. It takes constant time, the task
+ * with the earliest deadline is at the top of the scheduler's heap.
+ * Use it to sleep until the next task is due instead of waking up
+ * on every tick, e.g. (with interrupts disabled, so no task
+ * can become due unnoticed):
+ *
+ * ```c
+ * TickCount ticks = getTicksUntilNextDueTask(scheduler);
+ * if (ticks > 0)
+ *   {
+ *     sleepForTicks(ticks); // program the wake-up timer and sleep
+ *   }
+ * updateScheduledTasks(scheduler, ticks_slept);
+ * processScheduledTasks(scheduler);
+ * ```
+ */
+TickCount
+getTicksUntilNextDueTask(const PeriodicScheduler *self);
+
+/**
+ * Without catch-up, which is the default, a task that has
+ * missed several periods, e.g. because the MCU slept longer,
+ * is executed once and its next period starts with that execution.
+ * With catch-up enabled, processScheduledTasks() executes every
+ * missed instance of every task in the order of their deadlines,
+ * and each next deadline is one period after the missed one.
+ * So a single updateScheduledTasks(self, N) followed by
+ * processScheduledTasks() gives the same executions as N calls
+ * of updateScheduledTasks(self, 1), each followed by
+ * processScheduledTasks().
+ */
+void
+setSchedulerCatchUp(PeriodicScheduler *self,
+                    bool               enabled);
+
+/**
+ * Sets the timing of the task with the specified id.
+ * Tasks are added with PERIODIC_SCHEDULER_FIXED_DELAY.
+ * Catch-up (see setSchedulerCatchUp()) only applies to
+ * tasks with fixed delay, for them it has the same effect
+ * as PERIODIC_SCHEDULER_FIXED_RATE_RUN_ALL.
+ * Throws PERIODIC_SCHEDULER_INVALID_TASK_EXCEPTION if
+ * there is no such task.
+ */
+void
+setTaskTiming(PeriodicScheduler *self,
+              TaskId             id,
+              TaskTiming         timing);
+
+/**
+ * Returns the number of instances of the task with the
+ * specified id that have not been executed before the
+ * next instance became due, since the task has been added.
+ * Throws PERIODIC_SCHEDULER_INVALID_TASK_EXCEPTION if
+ * there is no such task.
+ */
+uint32_t
+getNumberOfMissedPeriods(const PeriodicScheduler *self,
+                         TaskId                   id);
+
+#if PERIODIC_SCHEDULER_PROFILING
+/**
+ * The profile of a task (see getTaskProfile()).
+ * Execution times are measured in the unit of the timestamp
+ * source (see setSchedulerTimestampSource()), e.g. cpu cycles,
+ * and stay 0 without one. The release jitter is the number of
+ * ticks between the deadline of an instance and its start.
+ * An overrun is counted whenever an instance completes a whole
+ * period or more after its deadline, i.e. after the next
+ * instance has become due.
+ */
+typedef struct TaskProfile
+{
+  uint32_t number_of_executions;
+  uint32_t min_execution_time;
+  uint32_t max_execution_time;
+  uint32_t mean_execution_time;
+  uint64_t total_execution_time;
+  TickCount max_release_jitter;
+  TickCount mean_release_jitter;
+  uint64_t total_release_jitter;
+  uint32_t number_of_overruns;
+} TaskProfile;
+
+/**
+ * Sets the function that returns the free-running timestamps
+ * the execution times are measured with, e.g. a cycle counter.
+ * Pass NULL to stop measuring execution times.
+ */
+void
+setSchedulerTimestampSource(PeriodicScheduler *self,
+                            uint32_t (*timestamp)(void));
+
+/**
+ * Copies the profile of the task with the specified id,
+ * recorded since the task has been added.
+ * All values are 0 as long as it has not been executed.
+ * Throws PERIODIC_SCHEDULER_INVALID_TASK_EXCEPTION if
+ * there is no such task.
+ */
+void
+getTaskProfile(const PeriodicScheduler *self,
+               TaskId                   id,
+               TaskProfile             *profile);
+#endif
+
 /**
  * Returns the number of bytes needed for a Scheduler that
  * can hold maximum_number_of_tasks.
  */
 size_t
-getSchedulersRequiredMemorySize(uint8_t maximum_number_of_tasks);
+getSchedulersRequiredMemorySize(TaskId maximum_number_of_tasks);
 
 /**
  * Each task is copied to the internal array of tasks.
@@ -131,14 +315,14 @@ getSchedulersRequiredMemorySize(uint8_t maximum_number_of_tasks);
  * Throws the PERIODIC_SCHEDULER_FULL_EXCEPTION when called while the
  * number of free slots is zero.
  */
-uint8_t
+TaskId
 addTaskToScheduler(PeriodicScheduler *self,
                    const Task        *task);
 
 /**
  * The same as addTaskToScheduler
  */
-uint8_t
+TaskId
 scheduleTaskPeriodically(PeriodicScheduler *self,
                          const Task        *task);
 
@@ -155,22 +339,24 @@ removeAllTasksFromSchedule(PeriodicScheduler *self);
  * the schedule.  */
 void
 removeScheduledTask(PeriodicScheduler *self,
-                    uint8_t id);
+                    TaskId id);
 
 /**
  * Returns the remain free slots in the schdule.
  * Use this function to determine how many tasks can still
  * be added to the scheduler.
  */
-uint8_t
+TaskId
 getNumberOfFreeSlotsInSchedule(const PeriodicScheduler *self);
 
 /**
- * Returns a pointer to the task with the specified id
+ * Returns a pointer to the task with the specified id.
+ * Its ticks_elapsed are updated to the ticks passed
+ * since the task has been added or executed the last time.
  */
 Task *
 getScheduledTaskById(const PeriodicScheduler *self,
-                     uint8_t index);
+                     TaskId index);
 
 /**
  * Creates a PeriodicScheduler struct at the given
@@ -183,12 +369,12 @@ getScheduledTaskById(const PeriodicScheduler *self,
  */
 PeriodicScheduler *
 createPeriodicScheduler(void   *memory,
-                        uint8_t maximum_number_of_tasks);
+                        TaskId  maximum_number_of_tasks);
 
 
 #define PERIODIC_SCHEDULER_SIZE(maximum_number_of_tasks) ((( \
 							     maximum_number_of_tasks) \
-                                                           * sizeof(InternalTask)) \
+                                                           * (sizeof(InternalTask) + sizeof(TaskId))) \
                                                           + sizeof( \
 							    PeriodicScheduler))
 
@@ -196,12 +382,26 @@ typedef struct InternalTask
 {
   Task task;
   bool is_valid;
+  TickCount next_due;
+  TaskId heap_index;
+  uint8_t timing;
+  uint32_t missed_periods;
+#if PERIODIC_SCHEDULER_PROFILING
+  TaskProfile profile;
+#endif
 } InternalTask;
 
 struct PeriodicScheduler
 {
   InternalTask *tasks;
-  const uint8_t limit;
+  const TaskId limit;
+  volatile TickCount tick_counter;
+  TaskId *heap;
+  TaskId number_of_tasks;
+  bool catch_up;
+#if PERIODIC_SCHEDULER_PROFILING
+  uint32_t (*timestamp)(void);
+#endif
 };
 
 #endif //PERIODICSCHEDULER_PERIODICSCHEDULER_H
@@ -0,0 +1,236 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "EmbeddedUtilities/Callback.h"
+#include "EmbeddedUtilities/MultiReaderBuffer.h"
+
+/**
+ * \file EmbeddedUtilities/Pipeline.h
+ *
+ * Chains processing stages, e.g. filter, decimate, encode and uplink, via MultiReaderBuffers.
+ * Each stage reads from its own reader of an input buffer and emits its results into an output buffer,
+ * which in turn is the input buffer of the next stage. The pipeline moves the items from stage to stage
+ * in batches: a stage function is called with all contiguous unread items of its reader (at most batch_size),
+ * which it processes in place, and the reader is advanced only after the function has returned.
+ *
+ * Backpressure: a batch is only handed to a stage if its output buffer has room for all items the stage
+ * may emit for it (max_outputs_per_input per input item). Otherwise the items wait in the input buffer,
+ * which fills up until pushToPipeline returns BUFFER_FULL to the producer. Thus no stage ever loses items,
+ * as long as all items are pushed via pushToPipeline and emitFromPipelineStage.
+ *
+ * On single threaded targets like the AVR, the main loop calls runPipelineOnce, which runs every stage
+ * with work once. On hosted targets the same pipeline, with the same stage functions, can be run by
+ * several worker threads (see PipelineWorkers), which set the lock and work_available callbacks.
+ * A stage never runs on two threads at once, but different stages run in parallel.
+ *
+ * With a timestamp source (see setPipelineTimestampSource), the metrics of each stage include the time
+ * spent in its stage function, so throughput and the latency of a batch can be derived per stage.
+ */
+
+typedef struct Pipeline Pipeline;
+typedef struct PipelineStage PipelineStage;
+
+/*!
+ * @brief	Processes a batch of items of a stage.
+ *
+ * Results are emitted via emitFromPipelineStage, at most max_outputs_per_input per processed item.
+ *
+ * @param stage
+ * 	The stage the batch belongs to
+ * @param context
+ * 	The context pointer of the stage
+ * @param items
+ * 	The items, pointing directly into the input buffer
+ * @param count
+ * 	The number of items, at least 1
+ */
+typedef void (*PipelineStageFunction)(PipelineStage *stage, void *context, const void *items, size_t count);
+
+/*!
+ * @struct PipelineStageConfig
+ *
+ * @brief	Describes a stage added via addStageToPipeline.
+ */
+typedef struct PipelineStageConfig
+{
+	PipelineStageFunction function;	//!< Processes the batches
+	void *context;	//!< Passed to the function, e.g. filter state
+	Buffer *input;	//!< The buffer the stage reads from; a reader is claimed for the stage
+	Buffer *output;	//!< The buffer the stage emits to, NULL for a sink stage
+	size_t max_outputs_per_input;	//!< The maximum number of items emitted per processed item
+	size_t batch_size;	//!< The maximum number of items per call of the function, 0 for no limit
+} PipelineStageConfig;
+
+/*!
+ * @struct PipelineStageMetrics
+ *
+ * @brief	Counters of a stage (see getPipelineStageMetrics).
+ *
+ * The throughput of a stage is consumed_items / busy_time, the mean latency of a batch busy_time / batches.
+ * Times are measured in the unit of the timestamp source and stay 0 without one.
+ */
+typedef struct PipelineStageMetrics
+{
+	uint64_t consumed_items;	//!< Number of items processed
+	uint64_t emitted_items;	//!< Number of items emitted to the output buffer
+	uint64_t dropped_items;	//!< Number of items that did not fit into the output buffer, since more than max_outputs_per_input were emitted
+	uint64_t batches;	//!< Number of calls of the stage function
+	uint64_t stalls;	//!< Number of times items were waiting, but the output buffer was too full
+	uint64_t busy_time;	//!< Total time spent in the stage function
+	uint32_t max_batch_time;	//!< Longest time spent in a single call of the stage function
+} PipelineStageMetrics;
+
+/*!
+ * @struct PipelineStage
+ *
+ * @brief	A stage of a pipeline, allocated by the user and set up by addStageToPipeline.
+ */
+struct PipelineStage
+{
+	PipelineStageConfig config;	//!< Stores the configuration of the stage
+	uint8_t reader_descriptor;	//!< Stores the reader of the stage at the input buffer
+	bool running;	//!< True while the stage function is called
+	Pipeline *pipeline;	//!< Stores the pipeline the stage belongs to
+	PipelineStage *next;	//!< Stores the next stage, stages run in the order they have been added
+	PipelineStageMetrics metrics;	//!< Stores the counters of the stage
+};
+
+/*!
+ * @struct Pipeline
+ *
+ * @brief	Defines the structure of the pipeline.
+ */
+struct Pipeline
+{
+	PipelineStage *first_stage;	//!< Stores the first stage that has been added
+	PipelineStage *last_stage;	//!< Stores the latest stage that has been added
+	uint32_t (*timestamp)(void);	//!< Stores the timestamp source, NULL if the time is not measured
+	GenericCallback lock;	//!< Guards the buffers and metrics, empty on single threaded targets
+	GenericCallback unlock;	//!< Releases the lock
+	GenericCallback work_available;	//!< Called whenever items or free space have been added, e.g. to wake up workers
+};
+
+/*!
+ * @brief	Initializes an empty pipeline without timestamp source.
+ *
+ * @param self
+ * 	A pointer to the pipeline
+ */
+void
+initPipeline(Pipeline *self);
+
+/*!
+ * @brief	Sets the function that is used to measure the time spent in the stage functions.
+ *
+ * @param self
+ * 	A pointer to the pipeline
+ * @param timestamp
+ * 	Returns a free-running timestamp, e.g. in microseconds; NULL to stop measuring
+ */
+void
+setPipelineTimestampSource(Pipeline *self, uint32_t (*timestamp)(void));
+
+/*!
+ * @brief	Appends a stage to the pipeline and claims a reader at its input buffer.
+ *
+ * Stages have to be added before the pipeline is run, upstream stages first. Each output buffer
+ * must be written to by a single stage only. The reader starts at the oldest item of the input buffer.
+ *
+ * @param self
+ * 	A pointer to the pipeline
+ * @param stage
+ * 	Memory for the stage, which has to stay valid as long as the pipeline is used
+ * @param config
+ * 	The configuration of the stage, which is copied
+ *
+ * @throws BUFFER_NO_FREE_READER_SLOTS_EXCEPTION
+ * 	An exception is thrown if the input buffer has no free reader slot
+ */
+void
+addStageToPipeline(Pipeline *self, PipelineStage *stage, const PipelineStageConfig *config);
+
+/*!
+ * @brief	Pushes items into a buffer of the pipeline, usually the input buffer of the first stage.
+ *
+ * The items are only pushed if all of them fit without overwriting items a stage has not read yet.
+ *
+ * @param self
+ * 	A pointer to the pipeline
+ * @param buffer
+ * 	The buffer to push to
+ * @param items
+ * 	The items to push
+ * @param count
+ * 	The number of items
+ *
+ * @returns
+ * 	BUFFER_OK if the items have been pushed; BUFFER_FULL if the stages are too slow and nothing has been pushed
+ */
+BufferStatus
+pushToPipeline(Pipeline *self, Buffer *buffer, const void *items, size_t count);
+
+/*!
+ * @brief	Emits results of a stage to its output buffer, called from within the stage function.
+ *
+ * Several calls per batch are allowed, as long as the stage emits at most max_outputs_per_input
+ * items per processed item in total; space for them has been reserved before the stage function was called.
+ *
+ * @param stage
+ * 	The stage passed to the stage function
+ * @param items
+ * 	The items to emit
+ * @param count
+ * 	The number of items
+ *
+ * @returns
+ * 	BUFFER_OK; BUFFER_FULL if the items do not fit, they are dropped then and counted as dropped_items
+ */
+BufferStatus
+emitFromPipelineStage(PipelineStage *stage, const void *items, size_t count);
+
+/*!
+ * @brief	Hands a single batch to a stage, if it has unread items and its output buffer has room for the results.
+ *
+ * @param self
+ * 	A pointer to the pipeline
+ * @param stage
+ * 	The stage to run
+ *
+ * @returns
+ * 	The number of items processed, 0 if the stage had no work or is already running on another thread
+ */
+size_t
+runPipelineStage(Pipeline *self, PipelineStage *stage);
+
+/*!
+ * @brief	Runs every stage once via runPipelineStage, upstream stages first.
+ *
+ * Single threaded targets call this from their main loop, e.g. until it returns 0.
+ *
+ * @param self
+ * 	A pointer to the pipeline
+ *
+ * @returns
+ * 	The total number of items processed by all stages
+ */
+size_t
+runPipelineOnce(Pipeline *self);
+
+/*!
+ * @brief	Copies the counters of a stage.
+ *
+ * @param self
+ * 	A pointer to the pipeline
+ * @param stage
+ * 	A stage of the pipeline
+ * @param metrics
+ * 	Returns the counters
+ */
+void
+getPipelineStageMetrics(Pipeline *self, const PipelineStage *stage, PipelineStageMetrics *metrics);
+
+#endif
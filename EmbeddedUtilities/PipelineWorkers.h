@@ -0,0 +1,76 @@
+#ifndef PIPELINE_WORKERS_H
+#define PIPELINE_WORKERS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "EmbeddedUtilities/Pipeline.h"
+
+/**
+ * \file EmbeddedUtilities/PipelineWorkers.h
+ *
+ * Runs a Pipeline on a pool of POSIX threads on hosted targets. The stage functions are the same
+ * as for runPipelineOnce on single threaded targets.
+ *
+ * Every worker calls runPipelineOnce in a loop, so different stages run in parallel while each stage
+ * runs on one worker at a time. Buffer accesses of the pipeline are serialized by a mutex, which is held
+ * only for the bookkeeping and copying of emitted items, never while a stage function processes a batch.
+ * Workers without work sleep on a condition variable until items or free space have been added.
+ *
+ * While the workers are running, the buffers of the pipeline must only be accessed via the pipeline,
+ * i.e. pushToPipeline and emitFromPipelineStage. Since nothing can be overwritten then, none of the
+ * buffer functions called by the workers throw.
+ */
+
+#ifndef PIPELINE_MAX_WORKERS
+#define PIPELINE_MAX_WORKERS 8
+#endif
+
+/*!
+ * @struct PipelineWorkers
+ *
+ * @brief	The state of the worker threads of a pipeline.
+ */
+typedef struct PipelineWorkers
+{
+	Pipeline *pipeline;	//!< The pipeline run by the workers
+	pthread_t threads[PIPELINE_MAX_WORKERS];	//!< The worker threads
+	size_t number_of_workers;	//!< The number of started worker threads
+	pthread_mutex_t mutex;	//!< Serializes the buffer accesses of the pipeline
+	pthread_cond_t work_available;	//!< Signaled when items or free space have been added
+	uint64_t work_counter;	//!< Incremented on every signal, so no wake up is missed
+	bool running;	//!< Cleared to stop the workers
+} PipelineWorkers;
+
+/*!
+ * @brief	Starts worker threads that run the pipeline until stopPipelineWorkers is called.
+ *
+ * @param self
+ * 	The state of the workers
+ * @param pipeline
+ * 	The pipeline, with all stages added
+ * @param number_of_workers
+ * 	The number of threads, 1 to PIPELINE_MAX_WORKERS
+ *
+ * @returns
+ * 	BUFFER_OK; BUFFER_INVALID_CAPACITY for an invalid number of workers;
+ * 	BUFFER_UNAVAILABLE if the threads could not be created, no worker is running then
+ */
+BufferStatus
+startPipelineWorkers(PipelineWorkers *self, Pipeline *pipeline, size_t number_of_workers);
+
+/*!
+ * @brief	Stops and joins the worker threads.
+ *
+ * Batches that are being processed are finished, items still waiting in the buffers stay there,
+ * so the pipeline can be drained with runPipelineOnce or started again.
+ *
+ * @param self
+ * 	The state of the workers
+ */
+void
+stopPipelineWorkers(PipelineWorkers *self);
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef SHARED_MULTI_READER_BUFFER_H
+#define SHARED_MULTI_READER_BUFFER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "EmbeddedUtilities/ConcurrentMultiReaderBuffer.h"
+
+/**
+ * \file EmbeddedUtilities/SharedMultiReaderBuffer.h
+ *
+ * Places a ConcurrentMultiReaderBuffer in POSIX shared memory (shm_open/mmap), so one producer
+ * process and several consumer processes can exchange items without sockets or pipes.
+ * The producer creates the buffer, consumers attach to it by name and claim a reader slot
+ * with getNewConcurrentBufferReaderDescriptor. All other operations are the ones of the
+ * ConcurrentMultiReaderBuffer, applied to SharedMultiReaderBuffer::buffer.
+ *
+ * The buffer layout contains no absolute pointers, so every process may map it at a different address.
+ * A consumer process that terminates without deleting its reader descriptor keeps its slot claimed,
+ * which stalls a producer that uses MULTI_READER_BUFFER_BLOCK_WHEN_FULL.
+ */
+
+/*!
+ * @struct SharedMultiReaderBuffer
+ *
+ * @brief	A process local handle to a buffer in shared memory.
+ */
+typedef struct SharedMultiReaderBuffer
+{
+	ConcurrentMultiReaderBuffer *buffer;	//!< The buffer inside the mapping, to be used with the ConcurrentMultiReaderBuffer functions
+	void *mapping;	//!< Start address of the mapping in this process
+	size_t mapping_size;	//!< Size of the mapping in byte
+} SharedMultiReaderBuffer;
+
+/*!
+ * @brief	Creates a new shared memory object and initializes a buffer in it.
+ *
+ * Fails if a shared memory object of that name exists already, e.g. left over by a
+ * producer that has not been shut down properly; use removeSharedMultiReaderBuffer first in that case.
+ * Consumers cannot attach before the buffer has been initialized completely.
+ *
+ * @param self
+ * 	The handle to be set up
+ * @param name
+ * 	The name of the shared memory object, starting with a slash (see shm_open)
+ * @param word_size
+ * 	The size in byte of the individual data items that should be managed in the buffer
+ * @param max_elements
+ * 	The maximum number of elements that the buffer should be able to hold at once; must be a power of two
+ * @param max_readers
+ * 	The maximum number of buffer readers that are allowed to exist in parallel
+ * @param options
+ * 	Bitwise combination of MultiReaderBufferOption values (see initConcurrentMultiReaderBufferWithOptions)
+ *
+ * @returns
+ * 	BUFFER_OK, BUFFER_INVALID_CAPACITY, or BUFFER_UNAVAILABLE if the shared memory could not be set up
+ */
+BufferStatus
+createSharedMultiReaderBuffer(SharedMultiReaderBuffer *self, const char *name, size_t word_size, size_t max_elements, size_t max_readers, MultiReaderBufferOptions options);
+
+/*!
+ * @brief	Maps an existing shared buffer into the calling process.
+ *
+ * @param self
+ * 	The handle to be set up
+ * @param name
+ * 	The name the buffer has been created with
+ *
+ * @returns
+ * 	BUFFER_OK, or BUFFER_UNAVAILABLE if no initialized buffer of that name exists
+ */
+BufferStatus
+attachSharedMultiReaderBuffer(SharedMultiReaderBuffer *self, const char *name);
+
+/*!
+ * @brief	Unmaps the buffer from the calling process.
+ *
+ * Reader descriptors claimed by the process should be deleted before.
+ * The shared memory object itself persists until removeSharedMultiReaderBuffer is called.
+ *
+ * @param self
+ * 	The handle of the buffer
+ */
+void
+detachSharedMultiReaderBuffer(SharedMultiReaderBuffer *self);
+
+/*!
+ * @brief	Removes the name of a shared buffer.
+ *
+ * Processes that are attached already keep their mapping, but no further process can attach.
+ *
+ * @param name
+ * 	The name the buffer has been created with
+ */
+void
+removeSharedMultiReaderBuffer(const char *name);
+
+#endif
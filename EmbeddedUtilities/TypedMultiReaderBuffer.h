@@ -0,0 +1,228 @@
+#ifndef TYPED_MULTI_READER_BUFFER_H
+#define TYPED_MULTI_READER_BUFFER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "EmbeddedUtilities/MultiReaderBuffer.h"
+
+/**
+ * \file EmbeddedUtilities/TypedMultiReaderBuffer.h
+ *
+ * Generates multi reader buffers for a fixed item type and capacity at compile time.
+ * The generated functions are static inline and copy items by assignment, and slot indexes
+ * are computed with a constant mask, so the compiler can inline and unroll accesses that go
+ * through void pointers and a runtime word size with the generic MultiReaderBuffer.
+ *
+ * The behaviour matches a MultiReaderBuffer initialized with MULTI_READER_BUFFER_POWER_OF_TWO_CAPACITY:
+ * the oldest items are overwritten when the buffer is full, overruns are detected when reading,
+ * reported via BUFFER_OVERRUN_EXCEPTION (or BUFFER_OVERRUN), and the reader continues with the oldest item.
+ *
+ * Example:
+ *
+ *     MULTI_READER_BUFFER_DEFINE(SampleBuffer, int16_t, 64, 2)
+ *
+ *     static SampleBuffer samples;
+ *
+ *     initSampleBuffer(&samples);
+ *     uint8_t reader = getNewSampleBufferReaderDescriptor(&samples);
+ *     pushToSampleBuffer(&samples, 42);
+ *     int16_t sample = popFromSampleBufferWithReader(&samples, reader);
+ */
+
+/*!
+ * @struct TypedBufferReader
+ *
+ * @brief	The state of a single reader slot of a generated buffer.
+ */
+typedef struct TypedBufferReader
+{
+	size_t position;	//!< Free-running position of the next item to be read
+	size_t lost_elements;	//!< Number of items lost by the latest overrun
+	BufferReaderState state;	//!< Current reader state, BUFFER_READER_VALID or BUFFER_READER_INVALID
+} TypedBufferReader;
+
+/*!
+ * @brief	Checks whether a reader of a generated buffer can read, used by the generated functions.
+ *
+ * Repositions an overrun reader to the oldest item, like the generic buffer does.
+ *
+ * @returns
+ * 	BUFFER_OK, BUFFER_EMPTY, BUFFER_OVERRUN or BUFFER_INVALID_READER
+ */
+static inline BufferStatus
+typedBufferReadingPossibility(TypedBufferReader *reader, size_t write, size_t stored_elements, size_t capacity)
+{
+  if (reader->state == BUFFER_READER_INVALID)
+  {
+    return BUFFER_INVALID_READER;
+  }
+
+  size_t unread_elements = write - reader->position;
+
+  if (unread_elements > capacity)
+  {
+    reader->lost_elements = unread_elements - capacity;
+    reader->position = write - stored_elements;
+    return BUFFER_OVERRUN;
+  }
+
+  if (unread_elements == 0)
+  {
+    return BUFFER_EMPTY;
+  }
+
+  return BUFFER_OK;
+}
+
+/*!
+ * @define MULTI_READER_BUFFER_DEFINE
+ *
+ * @brief	Defines the buffer type name and its static inline functions.
+ *
+ * For MULTI_READER_BUFFER_DEFINE(SampleBuffer, int16_t, 64, 2) the following is generated,
+ * each function behaving like its counterpart of the generic MultiReaderBuffer:
+ *
+ * 	typedef struct SampleBuffer SampleBuffer;
+ * 	void initSampleBuffer(SampleBuffer *self);
+ * 	void pushToSampleBuffer(SampleBuffer *self, int16_t item);
+ * 	uint8_t getNewSampleBufferReaderDescriptor(SampleBuffer *self);
+ * 	void deleteSampleBufferReaderDescriptor(SampleBuffer *self, uint8_t reader_descriptor);
+ * 	bool readableItemExistsForSampleBufferReader(const SampleBuffer *self, uint8_t reader_descriptor);
+ * 	int16_t peekAtSampleBufferWithReader(SampleBuffer *self, uint8_t reader_descriptor);
+ * 	int16_t popFromSampleBufferWithReader(SampleBuffer *self, uint8_t reader_descriptor);
+ * 	BufferStatus tryPopFromSampleBufferWithReader(SampleBuffer *self, uint8_t reader_descriptor, int16_t *item);
+ * 	size_t getNumberOfLostElementsForSampleBufferReader(const SampleBuffer *self, uint8_t reader_descriptor);
+ *
+ * Place it in a header to share the buffer type between translation units.
+ *
+ * @param name
+ * 	The name of the generated buffer type, also used in the function names
+ * @param type
+ * 	The item type, anything that can be assigned
+ * @param capacity
+ * 	The maximum number of items held at once; must be a power of two, checked at compile time
+ * @param max_readers
+ * 	The maximum number of buffer readers that are allowed to exist in parallel
+ */
+#define MULTI_READER_BUFFER_DEFINE(name, type, capacity, max_readers) \
+  typedef char name##CapacityMustBeAPowerOfTwo[((capacity) > 0 && ((capacity) & ((capacity) - 1)) == 0) ? 1 : -1]; \
+  \
+  typedef struct name \
+  { \
+    type items[capacity]; \
+    size_t write; \
+    size_t stored_elements; \
+    TypedBufferReader readers[max_readers]; \
+  } name; \
+  \
+  static inline void \
+  init##name(name *self) \
+  { \
+    self->write = 0; \
+    self->stored_elements = 0; \
+    for (size_t reader_slot = 0; reader_slot < (max_readers); ++reader_slot) \
+    { \
+      self->readers[reader_slot].state = BUFFER_READER_INVALID; \
+    } \
+  } \
+  \
+  static inline void \
+  pushTo##name(name *self, type item) \
+  { \
+    self->items[self->write & ((capacity) - 1)] = item; \
+    self->write++; \
+    if (self->stored_elements < (capacity)) \
+    { \
+      self->stored_elements++; \
+    } \
+  } \
+  \
+  static inline uint8_t \
+  getNew##name##ReaderDescriptor(name *self) \
+  { \
+    for (size_t reader_slot = 0; reader_slot < (max_readers); ++reader_slot) \
+    { \
+      if (self->readers[reader_slot].state == BUFFER_READER_INVALID) \
+      { \
+        self->readers[reader_slot].state = BUFFER_READER_VALID; \
+        self->readers[reader_slot].position = self->write - self->stored_elements; \
+        self->readers[reader_slot].lost_elements = 0; \
+        return reader_slot; \
+      } \
+    } \
+    Throw(BUFFER_NO_FREE_READER_SLOTS_EXCEPTION); \
+    return 0; \
+  } \
+  \
+  static inline void \
+  delete##name##ReaderDescriptor(name *self, uint8_t reader_descriptor) \
+  { \
+    if (reader_descriptor >= (max_readers)) \
+    { \
+      Throw(BUFFER_INVALID_READER_EXCEPTION); \
+    } \
+    self->readers[reader_descriptor].state = BUFFER_READER_INVALID; \
+  } \
+  \
+  static inline bool \
+  readableItemExistsFor##name##Reader(const name *self, uint8_t reader_descriptor) \
+  { \
+    return reader_descriptor < (max_readers) \
+      && self->readers[reader_descriptor].state != BUFFER_READER_INVALID \
+      && self->readers[reader_descriptor].position != self->write; \
+  } \
+  \
+  static inline BufferStatus \
+  tryPopFrom##name##WithReader(name *self, uint8_t reader_descriptor, type *item) \
+  { \
+    if (reader_descriptor >= (max_readers)) \
+    { \
+      return BUFFER_INVALID_READER; \
+    } \
+    TypedBufferReader *reader = self->readers + reader_descriptor; \
+    BufferStatus status = typedBufferReadingPossibility(reader, self->write, self->stored_elements, (capacity)); \
+    if (status == BUFFER_OK) \
+    { \
+      *item = self->items[reader->position & ((capacity) - 1)]; \
+      reader->position++; \
+    } \
+    return status; \
+  } \
+  \
+  static inline type \
+  peekAt##name##WithReader(name *self, uint8_t reader_descriptor) \
+  { \
+    if (reader_descriptor >= (max_readers)) \
+    { \
+      Throw(BUFFER_INVALID_READER_EXCEPTION); \
+    } \
+    TypedBufferReader *reader = self->readers + reader_descriptor; \
+    BufferStatus status = typedBufferReadingPossibility(reader, self->write, self->stored_elements, (capacity)); \
+    if (status != BUFFER_OK) \
+    { \
+      Throw(status); \
+    } \
+    return self->items[reader->position & ((capacity) - 1)]; \
+  } \
+  \
+  static inline type \
+  popFrom##name##WithReader(name *self, uint8_t reader_descriptor) \
+  { \
+    type item = peekAt##name##WithReader(self, reader_descriptor); \
+    self->readers[reader_descriptor].position++; \
+    return item; \
+  } \
+  \
+  static inline size_t \
+  getNumberOfLostElementsFor##name##Reader(const name *self, uint8_t reader_descriptor) \
+  { \
+    if (reader_descriptor >= (max_readers)) \
+    { \
+      Throw(BUFFER_INVALID_READER_EXCEPTION); \
+    } \
+    return self->readers[reader_descriptor].lost_elements; \
+  }
+
+#endif
@@ -0,0 +1,196 @@
+#ifndef WINDOW_STATISTICS_H
+#define WINDOW_STATISTICS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "EmbeddedUtilities/MultiReaderBuffer.h"
+
+/**
+ * \file EmbeddedUtilities/WindowStatistics.h
+ *
+ * Keeps the number of samples, minimum, maximum, mean and variance of the latest samples of a stream,
+ * e.g. of a MultiReaderBuffer reader, without walking through the window again for every new sample.
+ *
+ * Sums and sums of squares are updated by adding the new and subtracting the evicted samples.
+ * Minimum and maximum are the front of a monotonic deque each, which holds only the samples that can
+ * still become the minimum (maximum) before they leave the window, so each sample is added and removed once.
+ * All updates take amortized constant time per sample.
+ * Batches of samples are summed up in plain loops over arrays of the sample type, which the compiler can vectorize.
+ *
+ * Integer samples are summed up exactly in 64 bit, so the variance of int32_t samples is only correct
+ * as long as the window length times the largest squared sample fits into 64 bit.
+ * The sums of float samples are recalculated each time the window has been filled once more,
+ * so rounding errors do not accumulate.
+ */
+
+/*!
+ * @enum WindowSampleType
+ *
+ * @brief	Defines the supported sample types.
+ */
+typedef enum
+{
+	WINDOW_SAMPLES_INT16 = 0x00,	//!< Samples of type int16_t
+	WINDOW_SAMPLES_INT32 = 0x01,	//!< Samples of type int32_t
+	WINDOW_SAMPLES_FLOAT = 0x02	//!< Samples of type float
+} WindowSampleType;
+
+/*!
+ * @union WindowSample
+ *
+ * @brief	Holds a single sample, the member is selected by the WindowSampleType.
+ */
+typedef union WindowSample
+{
+	int16_t int16;	//!< Value of an int16_t sample
+	int32_t int32;	//!< Value of an int32_t sample
+	float float32;	//!< Value of a float sample
+} WindowSample;
+
+/*!
+ * @struct WindowStatisticsSummary
+ *
+ * @brief	The statistics of the current window (see getWindowStatistics).
+ */
+typedef struct WindowStatisticsSummary
+{
+	size_t number_of_samples;	//!< Number of samples in the window, less than the window length until it has been filled
+	WindowSample minimum;	//!< Smallest sample in the window
+	WindowSample maximum;	//!< Largest sample in the window
+	double mean;	//!< Arithmetic mean of the samples
+	double variance;	//!< Population variance of the samples
+} WindowStatisticsSummary;
+
+/*!
+ * @struct WindowDeque
+ *
+ * @brief	A double ended queue of slot indexes, stored in a ring behind the WindowStatistics struct.
+ */
+typedef struct WindowDeque
+{
+	size_t head;	//!< Ring index of the oldest entry
+	size_t length;	//!< Number of entries
+} WindowDeque;
+
+typedef struct WindowStatistics WindowStatistics;
+
+/*!
+ * @brief	Initializes an empty window.
+ *
+ * @param self
+ * 	Pointer to memory of WINDOW_STATISTICS_SIZE bytes
+ * @param sample_type
+ * 	The type of the samples
+ * @param window_length
+ * 	The number of latest samples the statistics refer to, at least 1
+ */
+void
+initWindowStatistics(WindowStatistics *self, WindowSampleType sample_type, size_t window_length);
+
+/*!
+ * @brief	Removes all samples from the window.
+ *
+ * @param self
+ * 	A pointer to the window
+ */
+void
+resetWindowStatistics(WindowStatistics *self);
+
+/*!
+ * @brief	Adds a sample, which evicts the oldest one once the window is full.
+ *
+ * @param self
+ * 	A pointer to the window
+ * @param sample
+ * 	Pointer to a sample of the configured type
+ */
+void
+addSampleToWindow(WindowStatistics *self, const void *sample);
+
+/*!
+ * @brief	Adds several samples at once, with the same result as adding them one by one.
+ *
+ * If there are more samples than fit into the window, only the latest window_length samples are used.
+ *
+ * @param self
+ * 	A pointer to the window
+ * @param samples
+ * 	Pointer to an array of samples of the configured type, oldest first
+ * @param count
+ * 	The number of samples
+ */
+void
+addSamplesToWindow(WindowStatistics *self, const void *samples, size_t count);
+
+/*!
+ * @brief	Adds all samples a buffer reader has not read yet and consumes them.
+ *
+ * The word size of the buffer has to match the sample type.
+ * The samples are added without copying them out of the buffer first.
+ *
+ * @param self
+ * 	A pointer to the window
+ * @param buffer
+ * 	A pointer to the buffer
+ * @param reader_descriptor
+ * 	The descriptor of the reader attached to the window
+ *
+ * @returns
+ * 	The number of samples added
+ *
+ * @throws BUFFER_INVALID_READER_EXCEPTION
+ * 	An exception is thrown if the reader descriptor is invalid
+ * @throws BUFFER_OVERRUN_EXCEPTION
+ * 	An exception is thrown if the reader has lost samples; it then points to the oldest sample,
+ * 	so the function can be called again
+ */
+size_t
+addSamplesFromBufferReader(WindowStatistics *self, Buffer *buffer, uint8_t reader_descriptor);
+
+/*!
+ * @brief	Returns the statistics of the samples currently in the window without walking through them.
+ *
+ * @param self
+ * 	A pointer to the window
+ * @param summary
+ * 	Returns the statistics; all values are 0 for an empty window
+ */
+void
+getWindowStatistics(const WindowStatistics *self, WindowStatisticsSummary *summary);
+
+/*!
+ * @define WINDOW_STATISTICS_SIZE
+ *
+ * @brief	Expands to the number of bytes required for a window with the provided parameters.
+ *
+ * @param sample_size
+ * 	The size of a sample in byte, e.g. sizeof(int16_t)
+ * @param window_length
+ * 	The number of latest samples the statistics refer to
+ */
+#define WINDOW_STATISTICS_SIZE(sample_size, window_length) (sizeof(WindowStatistics) + 2 * window_length * sizeof(size_t) + window_length * sample_size)
+
+/*!
+ * @struct WindowStatistics
+ *
+ * @brief	Defines the structure of the window.
+ *
+ * The rings of the minimum deque, the maximum deque and the samples follow the struct in this order.
+ */
+struct WindowStatistics
+{
+	WindowSampleType sample_type;	//!< Stores the type of the samples
+	size_t sample_size;	//!< Stores the size of a sample in byte
+	size_t window_length;	//!< Stores the maximum number of samples in the window
+	size_t number_of_samples;	//!< Stores the number of samples currently in the window
+	size_t write_index;	//!< Stores the slot the next sample is written to
+	int64_t integer_sum;	//!< Sum of the integer samples in the window
+	uint64_t integer_sum_of_squares;	//!< Sum of the squared integer samples in the window
+	double float_sum;	//!< Sum of the float samples in the window
+	double float_sum_of_squares;	//!< Sum of the squared float samples in the window
+	WindowDeque minimum;	//!< Slots of the samples that are candidates for the minimum, ascending values
+	WindowDeque maximum;	//!< Slots of the samples that are candidates for the maximum, descending values
+};
+
+#endif
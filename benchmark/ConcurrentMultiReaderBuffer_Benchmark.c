@@ -0,0 +1,97 @@
+#include "EmbeddedUtilities/ConcurrentMultiReaderBuffer.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define MAX_ELEMENTS (4096)
+#define MAX_READERS (16)
+#define NUMBER_OF_ITEMS (20000000)
+
+static _Alignas(CONCURRENT_MULTI_READER_BUFFER_CACHE_LINE_SIZE) uint8_t raw_memory[CONCURRENT_MULTI_READER_BUFFER_SIZE(sizeof(uint64_t), MAX_ELEMENTS, MAX_READERS)];
+static ConcurrentMultiReaderBuffer *buffer = (ConcurrentMultiReaderBuffer*) raw_memory;
+
+typedef struct ConsumerStatistics
+{
+  uint8_t reader;
+  uint64_t items_read;
+  uint64_t overruns;
+} ConsumerStatistics;
+
+static double
+secondsSince(const struct timespec *start)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void*
+consumeUntilLastItem(void *argument)
+{
+  ConsumerStatistics *statistics = (ConsumerStatistics*) argument;
+  uint64_t item = 0;
+
+  while (item + 1 < NUMBER_OF_ITEMS)
+  {
+    BufferStatus status = popFromConcurrentBufferWithReader(buffer, statistics->reader, &item);
+
+    if (status == BUFFER_OK)
+    {
+      statistics->items_read++;
+    }
+    else if (status == BUFFER_OVERRUN)
+    {
+      statistics->overruns++;
+    }
+  }
+
+  return NULL;
+}
+
+int
+main(int argc, char **argv)
+{
+  size_t max_consumers = (argc > 1) ? strtoul(argv[1], NULL, 10) : 8;
+
+  if (max_consumers > MAX_READERS)
+  {
+    max_consumers = MAX_READERS;
+  }
+
+  printf("consumers  producer [items/s]  per consumer [items/s]  delivered [%%]\n");
+  for (size_t number_of_consumers = 1; number_of_consumers <= max_consumers; number_of_consumers *= 2)
+  {
+    pthread_t consumers[MAX_READERS];
+    ConsumerStatistics statistics[MAX_READERS] = {{0}};
+
+    initConcurrentMultiReaderBuffer(buffer, sizeof(uint64_t), MAX_ELEMENTS, MAX_READERS);
+    for (size_t index = 0; index < number_of_consumers; ++index)
+    {
+      getNewConcurrentBufferReaderDescriptor(buffer, &statistics[index].reader);
+      pthread_create(consumers + index, NULL, consumeUntilLastItem, statistics + index);
+    }
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint64_t item = 0; item < NUMBER_OF_ITEMS; ++item)
+    {
+      pushToConcurrentBuffer(buffer, &item);
+    }
+    double producer_seconds = secondsSince(&start);
+
+    uint64_t items_read = 0;
+    for (size_t index = 0; index < number_of_consumers; ++index)
+    {
+      pthread_join(consumers[index], NULL);
+      items_read += statistics[index].items_read;
+    }
+    double consumer_seconds = secondsSince(&start);
+
+    printf("%9zu  %18.3e  %22.3e  %13.1f\n", number_of_consumers,
+           NUMBER_OF_ITEMS / producer_seconds,
+           items_read / consumer_seconds / number_of_consumers,
+           100.0 * items_read / ((double) NUMBER_OF_ITEMS * number_of_consumers));
+  }
+  return 0;
+}
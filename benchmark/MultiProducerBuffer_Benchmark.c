@@ -0,0 +1,100 @@
+#include "EmbeddedUtilities/ConcurrentMultiReaderBuffer.h"
+#include "EmbeddedUtilities/MultiReaderBuffer.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+/*
+ * Compares several producer threads feeding one buffer, either serialized by a mutex
+ * around the single writer MultiReaderBuffer or pushing to a ConcurrentMultiReaderBuffer
+ * with MULTI_READER_BUFFER_MULTIPLE_PRODUCERS. Only producer throughput is measured.
+ */
+
+#define MAX_ELEMENTS (4096)
+#define MAX_READERS (4)
+#define NUMBER_OF_ITEMS (8000000)
+#define MAX_PRODUCERS (8)
+
+static uint8_t locked_raw_memory[MULTI_READER_BUFFER_SIZE(sizeof(uint64_t), MAX_ELEMENTS, MAX_READERS)];
+static Buffer *locked_buffer = (Buffer*) locked_raw_memory;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+static _Alignas(CONCURRENT_MULTI_READER_BUFFER_CACHE_LINE_SIZE) uint8_t concurrent_raw_memory[CONCURRENT_MULTI_READER_BUFFER_SIZE(sizeof(uint64_t), MAX_ELEMENTS, MAX_READERS)];
+static ConcurrentMultiReaderBuffer *concurrent_buffer = (ConcurrentMultiReaderBuffer*) concurrent_raw_memory;
+
+static size_t items_per_producer;
+
+static double
+secondsSince(const struct timespec *start)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void*
+pushLocked(void *argument)
+{
+  (void) argument;
+
+  for (uint64_t item = 0; item < items_per_producer; ++item)
+  {
+    pthread_mutex_lock(&lock);
+    pushToBuffer(locked_buffer, &item);
+    pthread_mutex_unlock(&lock);
+  }
+
+  return NULL;
+}
+
+static void*
+pushConcurrently(void *argument)
+{
+  (void) argument;
+
+  for (uint64_t item = 0; item < items_per_producer; ++item)
+  {
+    pushToConcurrentBuffer(concurrent_buffer, &item);
+  }
+
+  return NULL;
+}
+
+static double
+measureItemsPerSecond(size_t number_of_producers, void *(*producer)(void*))
+{
+  pthread_t producers[MAX_PRODUCERS];
+  struct timespec start;
+
+  items_per_producer = NUMBER_OF_ITEMS / number_of_producers;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (size_t index = 0; index < number_of_producers; ++index)
+  {
+    pthread_create(producers + index, NULL, producer, NULL);
+  }
+
+  for (size_t index = 0; index < number_of_producers; ++index)
+  {
+    pthread_join(producers[index], NULL);
+  }
+
+  return items_per_producer * number_of_producers / secondsSince(&start);
+}
+
+int
+main(void)
+{
+  printf("producers  locked [items/s]  multi producer [items/s]\n");
+  for (size_t number_of_producers = 1; number_of_producers <= MAX_PRODUCERS; number_of_producers *= 2)
+  {
+    initMultiReaderBufferWithOptions((MultiReaderBuffer*) locked_buffer, sizeof(uint64_t), MAX_ELEMENTS, MAX_READERS, MULTI_READER_BUFFER_POWER_OF_TWO_CAPACITY);
+    double locked = measureItemsPerSecond(number_of_producers, pushLocked);
+
+    initConcurrentMultiReaderBufferWithOptions(concurrent_buffer, sizeof(uint64_t), MAX_ELEMENTS, MAX_READERS, MULTI_READER_BUFFER_MULTIPLE_PRODUCERS);
+    double concurrent = measureItemsPerSecond(number_of_producers, pushConcurrently);
+
+    printf("%9zu  %17.3e  %24.3e\n", number_of_producers, locked, concurrent);
+  }
+  return 0;
+}
@@ -0,0 +1,90 @@
+#include "EmbeddedUtilities/MultiReaderBuffer.h"
+#include <stdio.h>
+#include <time.h>
+
+#define BUFFER_WORD_SIZE (4)
+#define MAX_ELEMENTS (1024)
+#define MAX_READERS (1)
+#define NUMBER_OF_POLLS (20000000)
+
+static uint8_t raw_memory[MULTI_READER_BUFFER_SIZE(BUFFER_WORD_SIZE, MAX_ELEMENTS, MAX_READERS)];
+static Buffer *buffer = (Buffer*) raw_memory;
+static volatile uint32_t sink;
+
+static double
+secondsSince(const struct timespec *start)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static uint8_t
+setUpBuffer(void)
+{
+  initMultiReaderBuffer((MultiReaderBuffer*) raw_memory, BUFFER_WORD_SIZE, MAX_ELEMENTS, MAX_READERS);
+  return getNewBufferReaderDescriptor(buffer);
+}
+
+/* An item arrives once every items_every_polls polls, all other polls find the buffer empty */
+
+static double
+measurePollingWithExceptions(size_t items_every_polls)
+{
+  uint8_t reader = setUpBuffer();
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (uint32_t poll = 0; poll < NUMBER_OF_POLLS; ++poll)
+  {
+    if (poll % items_every_polls == 0)
+    {
+      pushToBuffer(buffer, &poll);
+    }
+
+    volatile CEXCEPTION_T exception;
+    Try
+    {
+      sink = *((const uint32_t*) popFromBufferWithReader(buffer, reader));
+    }
+    Catch (exception)
+    {
+      sink = exception;
+    }
+  }
+  return NUMBER_OF_POLLS / secondsSince(&start);
+}
+
+static double
+measurePollingWithStatus(size_t items_every_polls)
+{
+  uint8_t reader = setUpBuffer();
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (uint32_t poll = 0; poll < NUMBER_OF_POLLS; ++poll)
+  {
+    if (poll % items_every_polls == 0)
+    {
+      pushToBuffer(buffer, &poll);
+    }
+
+    const void *item;
+    if (tryPopFromBufferWithReader(buffer, reader, &item) == BUFFER_OK)
+    {
+      sink = *((const uint32_t*) item);
+    }
+  }
+  return NUMBER_OF_POLLS / secondsSince(&start);
+}
+
+int
+main(void)
+{
+  printf("items every n polls  popFromBufferWithReader [polls/s]  tryPopFromBufferWithReader [polls/s]\n");
+  for (size_t items_every_polls = 1; items_every_polls <= 1000; items_every_polls *= 10)
+  {
+    double with_exceptions = measurePollingWithExceptions(items_every_polls);
+    double with_status = measurePollingWithStatus(items_every_polls);
+    printf("%19zu  %34.3e  %37.3e\n", items_every_polls, with_exceptions, with_status);
+  }
+  return 0;
+}
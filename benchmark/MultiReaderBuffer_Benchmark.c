@@ -0,0 +1,97 @@
+#include "EmbeddedUtilities/MultiReaderBuffer.h"
+#include <stdio.h>
+#include <time.h>
+
+#define BUFFER_WORD_SIZE (4)
+#define MAX_ELEMENTS (1024)
+#define MAX_READERS (16)
+#define BURST_SIZE (256)
+#define NUMBER_OF_BURSTS (40000)
+
+static uint8_t raw_memory[MULTI_READER_BUFFER_SIZE(BUFFER_WORD_SIZE, MAX_ELEMENTS, MAX_READERS)];
+static Buffer *buffer = (Buffer*) raw_memory;
+static uint32_t burst[BURST_SIZE];
+static size_t active_readers;
+
+static double
+secondsSince(const struct timespec *start)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void
+setUpBufferWithReaders(size_t number_of_readers)
+{
+  initMultiReaderBuffer((MultiReaderBuffer*) raw_memory, BUFFER_WORD_SIZE, MAX_ELEMENTS, MAX_READERS);
+  active_readers = number_of_readers;
+  for (size_t reader = 0; reader < number_of_readers; ++reader)
+  {
+    getNewBufferReaderDescriptor(buffer);
+  }
+}
+
+static void
+consumeBurstWithAllReaders(void)
+{
+  for (size_t reader = 0; reader < active_readers; ++reader)
+  {
+    consumeWithReader(buffer, reader, BURST_SIZE);
+  }
+}
+
+static double
+measureSinglePushes(bool readers_keep_up)
+{
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (size_t round = 0; round < NUMBER_OF_BURSTS; ++round)
+  {
+    for (size_t index = 0; index < BURST_SIZE; ++index)
+    {
+      pushToBuffer(buffer, burst + index);
+    }
+    if (readers_keep_up)
+    {
+      consumeBurstWithAllReaders();
+    }
+  }
+  return (double) NUMBER_OF_BURSTS * BURST_SIZE / secondsSince(&start);
+}
+
+static double
+measureBatchPushes(void)
+{
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (size_t round = 0; round < NUMBER_OF_BURSTS; ++round)
+  {
+    pushManyToBuffer(buffer, burst, BURST_SIZE);
+  }
+  return (double) NUMBER_OF_BURSTS * BURST_SIZE / secondsSince(&start);
+}
+
+int
+main(void)
+{
+  for (size_t index = 0; index < BURST_SIZE; ++index)
+  {
+    burst[index] = index;
+  }
+
+  /* Idle readers are overrun by every push, readers that keep up consume after each burst */
+
+  printf("readers  pushToBuffer, idle readers [words/s]  pushToBuffer, readers keep up [words/s]  pushManyToBuffer [words/s]\n");
+  for (size_t number_of_readers = 1; number_of_readers <= MAX_READERS; number_of_readers *= 2)
+  {
+    setUpBufferWithReaders(number_of_readers);
+    double single_idle = measureSinglePushes(false);
+    setUpBufferWithReaders(number_of_readers);
+    double single_keeping_up = measureSinglePushes(true);
+    setUpBufferWithReaders(number_of_readers);
+    double batch = measureBatchPushes();
+    printf("%7zu  %37.3e  %40.3e  %26.3e\n", number_of_readers, single_idle, single_keeping_up, batch);
+  }
+  return 0;
+}
@@ -0,0 +1,127 @@
+#include "EmbeddedUtilities/PeriodicScheduler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*
+ * Compares the cost of a timer tick plus a pass of processScheduledTasks
+ * with the former implementation, which added the ticks to every slot
+ * in updateScheduledTasks and checked every slot in processScheduledTasks.
+ * Build with -DPERIODIC_SCHEDULER_WIDE_TASK_IDS=1 for more than 255 tasks.
+ */
+
+#define NUMBER_OF_TICKS (200000)
+#define MIN_PERIOD (10)
+#define MAX_PERIOD (1000)
+
+typedef struct LinearScanTask
+{
+  Task task;
+  bool is_valid;
+} LinearScanTask;
+
+static volatile uint32_t sink;
+
+static double
+secondsSince(const struct timespec *start)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void
+countCall(void *argument)
+{
+  (void) argument;
+  sink++;
+}
+
+static Ticks
+randomPeriod(void)
+{
+  return (Ticks) (MIN_PERIOD + rand() % (MAX_PERIOD - MIN_PERIOD + 1));
+}
+
+static double
+measureLinearScan(size_t number_of_tasks)
+{
+  LinearScanTask *tasks = calloc(number_of_tasks, sizeof(LinearScanTask));
+  srand(1);
+  for (size_t index = 0; index < number_of_tasks; index++)
+  {
+    tasks[index].task = (Task) {.function = countCall, .period = randomPeriod()};
+    tasks[index].is_valid = true;
+  }
+
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (uint32_t tick = 0; tick < NUMBER_OF_TICKS; ++tick)
+  {
+    for (size_t index = 0; index < number_of_tasks; index++)
+    {
+      if (tasks[index].is_valid)
+      {
+        tasks[index].task.ticks_elapsed += 1;
+      }
+    }
+    for (size_t index = 0; index < number_of_tasks; index++)
+    {
+      Task *task = &tasks[index].task;
+      if (task->ticks_elapsed >= task->period && tasks[index].is_valid)
+      {
+        task->function(task->argument);
+        task->ticks_elapsed = 0;
+      }
+    }
+  }
+  double seconds = secondsSince(&start);
+  free(tasks);
+  return seconds / NUMBER_OF_TICKS * 1e9;
+}
+
+static double
+measureScheduler(size_t number_of_tasks)
+{
+  void *memory = malloc(getSchedulersRequiredMemorySize((TaskId) number_of_tasks));
+  PeriodicScheduler *scheduler = createPeriodicScheduler(memory, (TaskId) number_of_tasks);
+  srand(1);
+  for (size_t index = 0; index < number_of_tasks; index++)
+  {
+    Task task = {.function = countCall, .period = randomPeriod()};
+    addTaskToScheduler(scheduler, &task);
+  }
+
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (uint32_t tick = 0; tick < NUMBER_OF_TICKS; ++tick)
+  {
+    updateScheduledTasks(scheduler, 1);
+    processScheduledTasks(scheduler);
+  }
+  double seconds = secondsSince(&start);
+  free(memory);
+  return seconds / NUMBER_OF_TICKS * 1e9;
+}
+
+int
+main(void)
+{
+  size_t numbers_of_tasks[] = {8, 64, 255, 10000};
+
+  printf("periods between %d and %d ticks, one pass per tick\n", MIN_PERIOD, MAX_PERIOD);
+  printf("tasks  linear scan [ns/tick]  min-heap [ns/tick]\n");
+  for (size_t index = 0; index < sizeof(numbers_of_tasks) / sizeof(numbers_of_tasks[0]); index++)
+  {
+    size_t number_of_tasks = numbers_of_tasks[index];
+    if (number_of_tasks > (TaskId) -1)
+    {
+      printf("%5zu  skipped, build with -DPERIODIC_SCHEDULER_WIDE_TASK_IDS=1\n", number_of_tasks);
+      continue;
+    }
+    double linear_scan = measureLinearScan(number_of_tasks);
+    double heap = measureScheduler(number_of_tasks);
+    printf("%5zu  %22.1f  %18.1f\n", number_of_tasks, linear_scan, heap);
+  }
+  return 0;
+}
@@ -0,0 +1,173 @@
+#include "EmbeddedUtilities/BufferSpillFile.h"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ *  Helper function
+ */
+static void
+appendSpilledItems(void *argument, const void *items, size_t count);
+
+/**
+ *  Helper function
+ */
+static bool
+resizeFile(BufferSpillFile *spill_file, size_t size);
+
+BufferStatus
+openBufferSpillFile(BufferSpillFile *self, Buffer *buffer, uint8_t reader_descriptor, const char *path, size_t segment_size)
+{
+  BufferSpillHandler handler = {appendSpilledItems, self};
+  BufferSpillHandler no_handler = {NULL, NULL};
+
+  self->buffer = buffer;
+  self->reader_descriptor = reader_descriptor;
+  self->word_size_in_byte = ((MultiReaderBuffer*) buffer)->word_size_in_byte;
+  self->segment_size_in_byte = segment_size * self->word_size_in_byte;
+  self->mapping = NULL;
+  self->mapping_size = 0;
+  self->read_offset = 0;
+  self->write_offset = 0;
+  self->lost_elements = 0;
+
+  setBufferSpillHandler(buffer, reader_descriptor, handler, segment_size);  // Can throw exceptions
+
+  self->file_descriptor = open(path, O_CREAT | O_TRUNC | O_RDWR, 0600);
+
+  if (self->file_descriptor < 0)
+  {
+    setBufferSpillHandler(buffer, reader_descriptor, no_handler, 0);
+    return BUFFER_UNAVAILABLE;
+  }
+
+  unlink(path);  // The file only lives as long as it is open
+
+  if (!resizeFile(self, self->segment_size_in_byte))
+  {
+    setBufferSpillHandler(buffer, reader_descriptor, no_handler, 0);
+    close(self->file_descriptor);
+    return BUFFER_UNAVAILABLE;
+  }
+
+  return BUFFER_OK;
+}
+
+void
+closeBufferSpillFile(BufferSpillFile *self)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self->buffer;
+
+  if (impl->durable_reader == self->reader_descriptor && impl->spill_handler.argument == self)
+  {
+    BufferSpillHandler no_handler = {NULL, NULL};
+
+    setBufferSpillHandler(self->buffer, self->reader_descriptor, no_handler, 0);
+  }
+
+  munmap(self->mapping, self->mapping_size);
+  close(self->file_descriptor);
+}
+
+BufferStatus
+popFromBufferWithSpillFile(BufferSpillFile *self, void *destination)
+{
+  if (self->read_offset < self->write_offset)
+  {
+    memcpy(destination, self->mapping + self->read_offset, self->word_size_in_byte);
+    self->read_offset += self->word_size_in_byte;
+
+    if (self->read_offset == self->write_offset)
+    {
+      /* Drained, start over and give back the disk space of a burst */
+
+      self->read_offset = 0;
+      self->write_offset = 0;
+
+      if (self->mapping_size > self->segment_size_in_byte)
+      {
+        resizeFile(self, self->segment_size_in_byte);
+      }
+    }
+
+    return BUFFER_OK;
+  }
+
+  if (self->lost_elements > 0)
+  {
+    self->lost_elements = 0;
+    return BUFFER_OVERRUN;
+  }
+
+  const void *item;
+  BufferStatus status = tryPopFromBufferWithReader(self->buffer, self->reader_descriptor, &item);
+
+  if (status == BUFFER_OK)
+  {
+    memcpy(destination, item, self->word_size_in_byte);
+  }
+
+  return status;
+}
+
+size_t
+getNumberOfSpilledElements(const BufferSpillFile *self)
+{
+  return (self->write_offset - self->read_offset) / self->word_size_in_byte;
+}
+
+/* Helper functions */
+
+void
+appendSpilledItems(void *argument, const void *items, size_t count)
+{
+  BufferSpillFile *spill_file = (BufferSpillFile*) argument;
+  size_t size_in_byte = count * spill_file->word_size_in_byte;
+
+  if (spill_file->write_offset + size_in_byte > spill_file->mapping_size)
+  {
+    size_t new_size = spill_file->mapping_size;
+
+    while (spill_file->write_offset + size_in_byte > new_size)
+    {
+      new_size += spill_file->segment_size_in_byte;
+    }
+
+    if (!resizeFile(spill_file, new_size))
+    {
+      spill_file->lost_elements += count;
+      return;
+    }
+  }
+
+  memcpy(spill_file->mapping + spill_file->write_offset, items, size_in_byte);
+  spill_file->write_offset += size_in_byte;
+}
+
+bool
+resizeFile(BufferSpillFile *spill_file, size_t size)
+{
+  if (ftruncate(spill_file->file_descriptor, size) != 0)
+  {
+    return false;
+  }
+
+  /* Map the new size before unmapping the old one, so the spilled items stay reachable if mapping fails */
+
+  void *mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, spill_file->file_descriptor, 0);
+
+  if (mapping == MAP_FAILED)
+  {
+    return false;
+  }
+
+  if (spill_file->mapping != NULL)
+  {
+    munmap(spill_file->mapping, spill_file->mapping_size);
+  }
+
+  spill_file->mapping = mapping;
+  spill_file->mapping_size = size;
+  return true;
+}
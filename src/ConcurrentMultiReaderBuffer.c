@@ -0,0 +1,701 @@
+#include "EmbeddedUtilities/ConcurrentMultiReaderBuffer.h"
+#include <string.h>
+#include <sched.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Reader slot state while a new reader is being set up. Producers ignore the slot
+ * until its sequence has been stored and the state has become BUFFER_READER_VALID.
+ */
+#define CONCURRENT_BUFFER_READER_CLAIMED (0x03)
+
+/**
+ *  Helper function
+ */
+static ConcurrentBufferReader*
+readerSlots(const ConcurrentMultiReaderBuffer *buffer);
+
+/**
+ *  Helper function
+ */
+static _Atomic uint64_t*
+slotStamps(const ConcurrentMultiReaderBuffer *buffer);
+
+/**
+ *  Helper function
+ */
+static uint8_t*
+slotData(const ConcurrentMultiReaderBuffer *buffer, uint64_t sequence);
+
+/**
+ *  Helper function
+ */
+static void
+storeSlotData(uint8_t *slot, const uint8_t *source, size_t size);
+
+/**
+ *  Helper function
+ */
+static void
+loadSlotData(uint8_t *destination, const uint8_t *slot, size_t size);
+
+/**
+ *  Helper function
+ */
+static BufferStatus
+claimReaderSlot(ConcurrentMultiReaderBuffer *buffer, uint8_t *reader_descriptor, bool is_group);
+
+/**
+ *  Helper function
+ */
+static bool
+copyItem(const ConcurrentMultiReaderBuffer *buffer, uint64_t sequence, uint64_t write_sequence, void *destination);
+
+/**
+ *  Helper function
+ */
+static bool
+advanceReader(ConcurrentBufferReader *reader, uint64_t *read_sequence, uint64_t new_read_sequence);
+
+/**
+ *  Helper function
+ */
+static uint64_t
+oldestSequence(const ConcurrentMultiReaderBuffer *buffer, uint64_t write_sequence);
+
+/**
+ *  Helper function
+ */
+static size_t
+freeSpaceBeforeSequence(const ConcurrentMultiReaderBuffer *buffer, uint64_t write_sequence);
+
+/**
+ *  Helper function
+ */
+static bool
+readerIsValid(const ConcurrentMultiReaderBuffer *buffer, uint8_t reader_descriptor);
+
+/**
+ *  Helper function
+ */
+static bool
+hasMultipleProducers(const ConcurrentMultiReaderBuffer *buffer);
+
+/**
+ *  Helper function
+ */
+static uint64_t
+claimedSequence(const ConcurrentMultiReaderBuffer *buffer);
+
+/**
+ *  Helper function
+ */
+static BufferStatus
+claimSequence(ConcurrentMultiReaderBuffer *buffer, uint64_t *sequence);
+
+/**
+ *  Helper function
+ */
+static void
+writeSlot(ConcurrentMultiReaderBuffer *buffer, uint64_t sequence, const void *data);
+
+/**
+ *  Helper function
+ */
+static void
+publishStampedSlots(ConcurrentMultiReaderBuffer *buffer);
+
+/**
+ *  Helper function
+ */
+static void
+wakeUpWaitingReaders(ConcurrentMultiReaderBuffer *buffer);
+
+/**
+ *  Helper function
+ */
+static bool
+sleepUntilWokenUp(ConcurrentMultiReaderBuffer *buffer, uint32_t wake_up_counter, const struct timespec *deadline);
+
+BufferStatus
+initConcurrentMultiReaderBuffer(ConcurrentMultiReaderBuffer *self, size_t word_size, size_t max_elements, size_t max_readers)
+{
+  return initConcurrentMultiReaderBufferWithOptions(self, word_size, max_elements, max_readers, MULTI_READER_BUFFER_DEFAULT_OPTIONS);
+}
+
+BufferStatus
+initConcurrentMultiReaderBufferWithOptions(ConcurrentMultiReaderBuffer *self, size_t word_size, size_t max_elements, size_t max_readers, MultiReaderBufferOptions options)
+{
+  if (max_elements == 0 || (max_elements & (max_elements - 1)) != 0)
+  {
+    return BUFFER_INVALID_CAPACITY;
+  }
+
+  self->word_size_in_byte = word_size;
+  self->max_elements = max_elements;
+  self->max_readers = max_readers;
+  self->options = options;
+  atomic_init(&self->write_sequence, 0);
+  atomic_init(&self->wake_up_counter, 0);
+  atomic_init(&self->number_of_waiting_readers, 0);
+  atomic_init(&self->claim_sequence, 0);
+
+  for (size_t reader_slot = 0; reader_slot < max_readers; ++reader_slot)
+  {
+    atomic_init(&readerSlots(self)[reader_slot].sequence, 0);
+    atomic_init(&readerSlots(self)[reader_slot].state, BUFFER_READER_INVALID);
+    readerSlots(self)[reader_slot].is_group = false;
+  }
+
+  for (size_t slot = 0; slot < max_elements; ++slot)
+  {
+    atomic_init(&slotStamps(self)[slot], 0);  // 0 marks a slot that holds no item
+  }
+
+  atomic_thread_fence(memory_order_release);
+  return BUFFER_OK;
+}
+
+BufferStatus
+pushToConcurrentBuffer(ConcurrentMultiReaderBuffer *self, const void *data)
+{
+  uint64_t sequence;
+  BufferStatus status = claimSequence(self, &sequence);
+
+  if (status != BUFFER_OK)
+  {
+    return status;
+  }
+
+  writeSlot(self, sequence, data);
+
+  /*
+   * Sequentially consistent, so either a reader about to wait sees the new item,
+   * or the producer sees the waiting reader (see waitForItemsWithConcurrentReader)
+   */
+
+  if (hasMultipleProducers(self))
+  {
+    publishStampedSlots(self);
+  }
+  else
+  {
+    atomic_store_explicit(&self->write_sequence, sequence + 1, memory_order_seq_cst);
+  }
+
+  if (atomic_load_explicit(&self->number_of_waiting_readers, memory_order_seq_cst) != 0)
+  {
+    wakeUpWaitingReaders(self);
+  }
+
+  return BUFFER_OK;
+}
+
+size_t
+getFreeSpaceOfConcurrentBuffer(const ConcurrentMultiReaderBuffer *self)
+{
+  return freeSpaceBeforeSequence(self, claimedSequence(self));
+}
+
+BufferStatus
+getNewConcurrentBufferReaderDescriptor(ConcurrentMultiReaderBuffer *self, uint8_t *reader_descriptor)
+{
+  return claimReaderSlot(self, reader_descriptor, false);
+}
+
+BufferStatus
+getNewConcurrentBufferGroupDescriptor(ConcurrentMultiReaderBuffer *self, uint8_t *group_descriptor)
+{
+  return claimReaderSlot(self, group_descriptor, true);
+}
+
+BufferStatus
+deleteConcurrentBufferReaderDescriptor(ConcurrentMultiReaderBuffer *self, uint8_t reader_descriptor)
+{
+  if (reader_descriptor >= self->max_readers)
+  {
+    return BUFFER_INVALID_READER;
+  }
+
+  atomic_store_explicit(&readerSlots(self)[reader_descriptor].state, BUFFER_READER_INVALID, memory_order_release);
+  return BUFFER_OK;
+}
+
+bool
+readableItemExistsForConcurrentReader(const ConcurrentMultiReaderBuffer *self, uint8_t reader_descriptor)
+{
+  if (!readerIsValid(self, reader_descriptor))
+  {
+    return false;
+  }
+
+  uint64_t read_sequence = atomic_load_explicit(&readerSlots(self)[reader_descriptor].sequence, memory_order_relaxed);
+
+  return read_sequence != atomic_load_explicit((_Atomic uint64_t*) &self->write_sequence, memory_order_acquire);
+}
+
+BufferStatus
+popFromConcurrentBufferWithReader(ConcurrentMultiReaderBuffer *self, uint8_t reader_descriptor, void *destination)
+{
+  if (!readerIsValid(self, reader_descriptor))
+  {
+    return BUFFER_INVALID_READER;
+  }
+
+  ConcurrentBufferReader *reader = readerSlots(self) + reader_descriptor;
+  uint64_t read_sequence = atomic_load_explicit(&reader->sequence, memory_order_relaxed);
+
+  while (true)
+  {
+    uint64_t write_sequence = atomic_load_explicit(&self->write_sequence, memory_order_acquire);
+
+    if (read_sequence == write_sequence)
+    {
+      return BUFFER_EMPTY;
+    }
+
+    if (copyItem(self, read_sequence, write_sequence, destination))
+    {
+      if (advanceReader(reader, &read_sequence, read_sequence + 1))
+      {
+        return BUFFER_OK;
+      }
+
+      continue;  // Another consumer of the group has taken the item, try the next one
+    }
+
+    /* The item has been overwritten before or while it was copied, so it is lost in any case */
+
+    write_sequence = atomic_load_explicit(&self->write_sequence, memory_order_acquire);
+
+    uint64_t oldest_sequence = oldestSequence(self, write_sequence);
+
+    if (advanceReader(reader, &read_sequence, (oldest_sequence > read_sequence) ? oldest_sequence : read_sequence + 1))
+    {
+      return BUFFER_OVERRUN;
+    }
+  }
+}
+
+BufferStatus
+getConcurrentBufferReaderSequenceNumber(const ConcurrentMultiReaderBuffer *self, uint8_t reader_descriptor, uint64_t *sequence_number)
+{
+  if (!readerIsValid(self, reader_descriptor))
+  {
+    return BUFFER_INVALID_READER;
+  }
+
+  *sequence_number = atomic_load_explicit(&readerSlots(self)[reader_descriptor].sequence, memory_order_acquire);
+  return BUFFER_OK;
+}
+
+BufferStatus
+seekConcurrentBufferReaderToSequenceNumber(ConcurrentMultiReaderBuffer *self, uint8_t reader_descriptor, uint64_t sequence_number)
+{
+  if (!readerIsValid(self, reader_descriptor))
+  {
+    return BUFFER_INVALID_READER;
+  }
+
+  uint64_t write_sequence = atomic_load_explicit(&self->write_sequence, memory_order_acquire);
+
+  if (sequence_number < oldestSequence(self, write_sequence))
+  {
+    return BUFFER_EVICTED;
+  }
+
+  if (sequence_number > write_sequence)
+  {
+    return BUFFER_EMPTY;
+  }
+
+  atomic_store_explicit(&readerSlots(self)[reader_descriptor].sequence, sequence_number, memory_order_release);
+  return BUFFER_OK;
+}
+
+BufferStatus
+waitForItemsWithConcurrentReader(ConcurrentMultiReaderBuffer *self, uint8_t reader_descriptor, uint32_t timeout_in_milliseconds)
+{
+  if (!readerIsValid(self, reader_descriptor))
+  {
+    return BUFFER_INVALID_READER;
+  }
+
+  if (readableItemExistsForConcurrentReader(self, reader_descriptor))
+  {
+    return BUFFER_OK;  // Common case for a busy producer, no need to register as waiting
+  }
+
+  struct timespec deadline;
+
+  clock_gettime(CLOCK_MONOTONIC, &deadline);
+  deadline.tv_sec += timeout_in_milliseconds / 1000;
+  deadline.tv_nsec += (long) (timeout_in_milliseconds % 1000) * 1000000;
+
+  if (deadline.tv_nsec >= 1000000000)
+  {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000;
+  }
+
+  BufferStatus status = BUFFER_EMPTY;
+
+  atomic_fetch_add_explicit(&self->number_of_waiting_readers, 1, memory_order_seq_cst);
+
+  while (true)
+  {
+    /* Read the counter before checking, so a wake-up in between makes the futex return immediately */
+
+    uint32_t wake_up_counter = atomic_load_explicit(&self->wake_up_counter, memory_order_seq_cst);
+
+    if (readableItemExistsForConcurrentReader(self, reader_descriptor))
+    {
+      status = BUFFER_OK;
+      break;
+    }
+
+    if (!sleepUntilWokenUp(self, wake_up_counter, &deadline))
+    {
+      status = readableItemExistsForConcurrentReader(self, reader_descriptor) ? BUFFER_OK : BUFFER_EMPTY;
+      break;
+    }
+  }
+
+  atomic_fetch_sub_explicit(&self->number_of_waiting_readers, 1, memory_order_relaxed);
+  return status;
+}
+
+/* Helper functions */
+
+ConcurrentBufferReader*
+readerSlots(const ConcurrentMultiReaderBuffer *buffer)
+{
+  return (ConcurrentBufferReader*) (buffer + 1);
+}
+
+_Atomic uint64_t*
+slotStamps(const ConcurrentMultiReaderBuffer *buffer)
+{
+  return (_Atomic uint64_t*) (readerSlots(buffer) + buffer->max_readers);
+}
+
+uint8_t*
+slotData(const ConcurrentMultiReaderBuffer *buffer, uint64_t sequence)
+{
+  uint8_t *data = (uint8_t*) (slotStamps(buffer) + buffer->max_elements);
+
+  return data + (sequence & (buffer->max_elements - 1)) * buffer->word_size_in_byte;
+}
+
+/*
+ * Readers copy a slot while the producer may be overwriting it and detect torn copies by the stamp
+ * afterwards (seqlock). The payload is therefore accessed via relaxed atomics, since plain
+ * concurrent accesses would be a data race: whole words if the slot is aligned, bytes otherwise.
+ */
+
+void
+storeSlotData(uint8_t *slot, const uint8_t *source, size_t size)
+{
+  size_t offset = 0;
+
+  if ((uintptr_t) slot % sizeof(uint64_t) == 0)
+  {
+    for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t))
+    {
+      uint64_t word;
+
+      memcpy(&word, source + offset, sizeof(uint64_t));
+      atomic_store_explicit((_Atomic uint64_t*) (slot + offset), word, memory_order_relaxed);
+    }
+  }
+
+  for (; offset < size; ++offset)
+  {
+    atomic_store_explicit((_Atomic uint8_t*) (slot + offset), source[offset], memory_order_relaxed);
+  }
+}
+
+void
+loadSlotData(uint8_t *destination, const uint8_t *slot, size_t size)
+{
+  size_t offset = 0;
+
+  if ((uintptr_t) slot % sizeof(uint64_t) == 0)
+  {
+    for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t))
+    {
+      uint64_t word = atomic_load_explicit((_Atomic uint64_t*) (slot + offset), memory_order_relaxed);
+
+      memcpy(destination + offset, &word, sizeof(uint64_t));
+    }
+  }
+
+  for (; offset < size; ++offset)
+  {
+    destination[offset] = atomic_load_explicit((_Atomic uint8_t*) (slot + offset), memory_order_relaxed);
+  }
+}
+
+BufferStatus
+claimReaderSlot(ConcurrentMultiReaderBuffer *buffer, uint8_t *reader_descriptor, bool is_group)
+{
+  for (size_t reader_slot = 0; reader_slot < buffer->max_readers; ++reader_slot)
+  {
+    ConcurrentBufferReader *reader = readerSlots(buffer) + reader_slot;
+    uint8_t expected_state = BUFFER_READER_INVALID;
+
+    if (atomic_compare_exchange_strong(&reader->state, &expected_state, CONCURRENT_BUFFER_READER_CLAIMED))
+    {
+      uint64_t write_sequence = atomic_load_explicit(&buffer->write_sequence, memory_order_acquire);
+
+      reader->is_group = is_group;
+      atomic_store_explicit(&reader->sequence, oldestSequence(buffer, write_sequence), memory_order_relaxed);
+      atomic_store_explicit(&reader->state, BUFFER_READER_VALID, memory_order_release);
+      *reader_descriptor = reader_slot;
+      return BUFFER_OK;
+    }
+  }
+
+  return BUFFER_NO_FREE_READER_SLOTS;
+}
+
+bool
+copyItem(const ConcurrentMultiReaderBuffer *buffer, uint64_t sequence, uint64_t write_sequence, void *destination)
+{
+  _Atomic uint64_t *stamp = slotStamps(buffer) + (sequence & (buffer->max_elements - 1));
+
+  if (write_sequence - sequence > buffer->max_elements
+      || atomic_load_explicit(stamp, memory_order_acquire) != sequence + 1)
+  {
+    return false;
+  }
+
+  loadSlotData(destination, slotData(buffer, sequence), buffer->word_size_in_byte);
+  atomic_thread_fence(memory_order_acquire);
+
+  return atomic_load_explicit(stamp, memory_order_relaxed) == sequence + 1;
+}
+
+bool
+advanceReader(ConcurrentBufferReader *reader, uint64_t *read_sequence, uint64_t new_read_sequence)
+{
+  if (!reader->is_group)
+  {
+    atomic_store_explicit(&reader->sequence, new_read_sequence, memory_order_release);
+    return true;
+  }
+
+  /*
+   * The cursor only moves once the item has been copied, so the producer never overwrites
+   * an item a consumer is still copying in the blocking mode. On failure read_sequence
+   * is updated to the item the winning consumer left for the others.
+   */
+
+  return atomic_compare_exchange_strong_explicit(&reader->sequence, read_sequence, new_read_sequence, memory_order_release, memory_order_relaxed);
+}
+
+uint64_t
+oldestSequence(const ConcurrentMultiReaderBuffer *buffer, uint64_t write_sequence)
+{
+  return (write_sequence > buffer->max_elements) ? write_sequence - buffer->max_elements : 0;
+}
+
+size_t
+freeSpaceBeforeSequence(const ConcurrentMultiReaderBuffer *buffer, uint64_t write_sequence)
+{
+  uint64_t slowest_unread_elements = 0;
+
+  for (size_t reader_slot = 0; reader_slot < buffer->max_readers; ++reader_slot)
+  {
+    if (readerIsValid(buffer, reader_slot))
+    {
+      uint64_t unread_elements = write_sequence - atomic_load_explicit(&readerSlots(buffer)[reader_slot].sequence, memory_order_acquire);
+
+      if (unread_elements > slowest_unread_elements)
+      {
+        slowest_unread_elements = unread_elements;
+      }
+    }
+  }
+
+  if (slowest_unread_elements >= buffer->max_elements)
+  {
+    return 0;
+  }
+
+  return buffer->max_elements - slowest_unread_elements;
+}
+
+BufferStatus
+claimSequence(ConcurrentMultiReaderBuffer *buffer, uint64_t *sequence)
+{
+  bool must_not_overwrite = buffer->options & (MULTI_READER_BUFFER_REJECT_WHEN_FULL | MULTI_READER_BUFFER_BLOCK_WHEN_FULL);
+
+  if (!hasMultipleProducers(buffer))
+  {
+    *sequence = atomic_load_explicit(&buffer->write_sequence, memory_order_relaxed);
+
+    while (must_not_overwrite && freeSpaceBeforeSequence(buffer, *sequence) == 0)
+    {
+      if (!(buffer->options & MULTI_READER_BUFFER_BLOCK_WHEN_FULL))
+      {
+        return BUFFER_FULL;
+      }
+
+      sched_yield();  // Give the slowest reader a chance to advance
+    }
+
+    return BUFFER_OK;
+  }
+
+  if (!must_not_overwrite)
+  {
+    *sequence = atomic_fetch_add_explicit(&buffer->claim_sequence, 1, memory_order_relaxed);
+  }
+  else
+  {
+    /* Claim only if there is room, otherwise two producers could take the last free slot */
+
+    *sequence = atomic_load_explicit(&buffer->claim_sequence, memory_order_relaxed);
+
+    do
+    {
+      while (freeSpaceBeforeSequence(buffer, *sequence) == 0)
+      {
+        if (!(buffer->options & MULTI_READER_BUFFER_BLOCK_WHEN_FULL))
+        {
+          return BUFFER_FULL;
+        }
+
+        sched_yield();
+        *sequence = atomic_load_explicit(&buffer->claim_sequence, memory_order_relaxed);
+      }
+    } while (!atomic_compare_exchange_weak_explicit(&buffer->claim_sequence, sequence, *sequence + 1, memory_order_relaxed, memory_order_relaxed));
+  }
+
+  /*
+   * The slot still belongs to the item one lap ahead until that item has been published,
+   * otherwise the published sequence could get stuck at an overwritten stamp
+   */
+
+  while (atomic_load_explicit(&buffer->write_sequence, memory_order_acquire) + buffer->max_elements <= *sequence)
+  {
+    sched_yield();
+  }
+
+  return BUFFER_OK;
+}
+
+void
+writeSlot(ConcurrentMultiReaderBuffer *buffer, uint64_t sequence, const void *data)
+{
+  _Atomic uint64_t *stamp = slotStamps(buffer) + (sequence & (buffer->max_elements - 1));
+
+  /*
+   * Invalidate the stamp before touching the data, so readers copying the old item
+   * notice that it is being overwritten (seqlock scheme)
+   */
+
+  atomic_store_explicit(stamp, 0, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+
+  storeSlotData(slotData(buffer, sequence), data, buffer->word_size_in_byte);
+
+  atomic_store_explicit(stamp, sequence + 1, memory_order_release);
+}
+
+void
+publishStampedSlots(ConcurrentMultiReaderBuffer *buffer)
+{
+  /*
+   * Advance the published sequence over all slots stamped in order. Whichever producer
+   * finishes last publishes the items of the others, so no producer waits for another.
+   * The fence orders the own stamp before the loads below: of two producers finishing
+   * adjacent slots, at least one sees the stamp of the other, so no item stays unpublished.
+   */
+
+  atomic_thread_fence(memory_order_seq_cst);
+
+  uint64_t published = atomic_load_explicit(&buffer->write_sequence, memory_order_seq_cst);
+
+  while (atomic_load_explicit(slotStamps(buffer) + (published & (buffer->max_elements - 1)), memory_order_acquire) == published + 1)
+  {
+    if (atomic_compare_exchange_strong_explicit(&buffer->write_sequence, &published, published + 1, memory_order_seq_cst, memory_order_seq_cst))
+    {
+      published++;
+    }
+  }
+}
+
+uint64_t
+claimedSequence(const ConcurrentMultiReaderBuffer *buffer)
+{
+  if (hasMultipleProducers(buffer))
+  {
+    return atomic_load_explicit((_Atomic uint64_t*) &buffer->claim_sequence, memory_order_acquire);
+  }
+
+  return atomic_load_explicit((_Atomic uint64_t*) &buffer->write_sequence, memory_order_acquire);
+}
+
+bool
+hasMultipleProducers(const ConcurrentMultiReaderBuffer *buffer)
+{
+  return buffer->options & MULTI_READER_BUFFER_MULTIPLE_PRODUCERS;
+}
+
+void
+wakeUpWaitingReaders(ConcurrentMultiReaderBuffer *buffer)
+{
+  atomic_fetch_add_explicit(&buffer->wake_up_counter, 1, memory_order_seq_cst);
+#ifdef __linux__
+  syscall(SYS_futex, &buffer->wake_up_counter, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+}
+
+bool
+sleepUntilWokenUp(ConcurrentMultiReaderBuffer *buffer, uint32_t wake_up_counter, const struct timespec *deadline)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  if (now.tv_sec > deadline->tv_sec || (now.tv_sec == deadline->tv_sec && now.tv_nsec >= deadline->tv_nsec))
+  {
+    return false;  // Timed out
+  }
+
+#ifdef __linux__
+  /* FUTEX_WAIT expects a relative timeout; not private, since the buffer may be shared between processes */
+
+  struct timespec remaining = {deadline->tv_sec - now.tv_sec, deadline->tv_nsec - now.tv_nsec};
+
+  if (remaining.tv_nsec < 0)
+  {
+    remaining.tv_sec--;
+    remaining.tv_nsec += 1000000000;
+  }
+
+  syscall(SYS_futex, &buffer->wake_up_counter, FUTEX_WAIT, wake_up_counter, &remaining, NULL, 0);
+#else
+  (void) buffer;
+  (void) wake_up_counter;
+  sched_yield();
+#endif
+
+  return true;  // Woken up, interrupted or counter changed already, the caller checks again
+}
+
+bool
+readerIsValid(const ConcurrentMultiReaderBuffer *buffer, uint8_t reader_descriptor)
+{
+  return reader_descriptor < buffer->max_readers
+    && atomic_load_explicit(&readerSlots(buffer)[reader_descriptor].state, memory_order_acquire) == BUFFER_READER_VALID;
+}
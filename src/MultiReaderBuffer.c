@@ -1,17 +1,188 @@
 #include "EmbeddedUtilities/MultiReaderBuffer.h"
 #include "CException.h"
+#include <string.h>
 
 /**
  *  Helper function
  */
-static void
-copyMemory(void *destination, const void *source, uint8_t number_of_bytes);
+static BufferReader*
+readerSlots(const MultiReaderBuffer *buffer);
+
+/**
+ *  Helper function
+ */
+static uint8_t*
+bufferStorage(const MultiReaderBuffer *buffer);
+
+/**
+ *  Helper function
+ */
+static uint8_t*
+activeReaderBitmap(const MultiReaderBuffer *buffer);
+
+/**
+ *  Helper function
+ */
+static bool
+hasPowerOfTwoCapacity(const MultiReaderBuffer *buffer);
+
+/**
+ *  Helper function
+ */
+static bool
+rejectsWhenFull(const MultiReaderBuffer *buffer);
+
+/**
+ *  Helper function
+ */
+static size_t
+slotIndex(const MultiReaderBuffer *buffer, size_t position);
 
 /**
  *  Helper function
  */
 static void*
-nextWordPosition(MultiReaderBuffer *buffer, void *pointer);
+slotPointer(const MultiReaderBuffer *buffer, size_t position);
+
+/**
+ *  Helper function
+ */
+static size_t
+advancePosition(const MultiReaderBuffer *buffer, size_t position, size_t count);
+
+/**
+ *  Helper function
+ */
+static size_t
+positionBefore(const MultiReaderBuffer *buffer, size_t position, size_t count);
+
+/**
+ *  Helper function
+ */
+static size_t
+numberOfUnreadElements(const MultiReaderBuffer *buffer, size_t reader_position);
+
+/**
+ *  Helper function
+ */
+static size_t
+oldestPosition(const MultiReaderBuffer *buffer);
+
+/**
+ *  Helper function
+ */
+static uint64_t
+oldestSequenceNumber(const MultiReaderBuffer *buffer);
+
+/**
+ *  Helper function
+ */
+static void
+moveReaderToSequenceNumber(MultiReaderBuffer *buffer, BufferReader *reader, uint64_t sequence_number);
+
+/**
+ *  Helper function
+ */
+static void
+addStoredElements(MultiReaderBuffer *buffer, size_t count);
+
+/**
+ *  Helper function
+ */
+static size_t
+nextActiveReader(const MultiReaderBuffer *buffer, size_t reader_slot);
+
+/**
+ *  Helper function
+ */
+static void
+refreshSlowestReader(MultiReaderBuffer *buffer);
+
+/**
+ *  Helper function
+ */
+static bool
+slowestReaderHasRoomFor(MultiReaderBuffer *buffer, size_t count);
+
+/**
+ *  Helper function
+ */
+static void
+markReaderOverrun(BufferReader *reader, size_t lost_elements);
+
+/**
+ *  Helper function
+ */
+static void
+moveReadersOverrunByElements(MultiReaderBuffer *buffer, size_t count);
+
+/**
+ *  Helper function
+ */
+static void
+advanceReader(MultiReaderBuffer *buffer, BufferReader *reader, size_t count);
+
+/**
+ *  Helper function
+ */
+static bool
+hasDurableReader(const MultiReaderBuffer *buffer);
+
+/**
+ *  Helper function
+ */
+static void
+spillItemsOfDurableReader(MultiReaderBuffer *buffer, size_t count);
+
+/**
+ *  Helper function
+ */
+static void
+notifyReaders(MultiReaderBuffer *buffer);
+
+/**
+ *  Helper function
+ */
+static void
+countPushedElements(MultiReaderBuffer *buffer, size_t count);
+
+/**
+ *  Helper function
+ */
+static void
+countConsumedElements(BufferReader *reader, size_t count);
+
+/**
+ *  Helper function
+ */
+static void
+recordReaderLag(MultiReaderBuffer *buffer, BufferReader *reader);
+
+#if MULTI_READER_BUFFER_METRICS
+/**
+ *  Helper function
+ */
+static size_t
+unreadElementsStillStored(MultiReaderBuffer *buffer, BufferReader *reader);
+#endif
+
+/**
+ *  Helper function
+ */
+static BufferStatus
+readerUsability(MultiReaderBuffer *buffer, uint8_t reader_descriptor);
+
+/**
+ *  Helper function
+ */
+static BufferStatus
+readingPossibility(MultiReaderBuffer *buffer, uint8_t reader_descriptor);
+
+/**
+ *  Helper function
+ */
+static void
+checkIfReaderIsUsable(MultiReaderBuffer *buffer, uint8_t reader_descriptor);
 
 /**
  *  Helper function
@@ -20,177 +191,1042 @@ static void
 checkIfReadingIsPossible(MultiReaderBuffer *buffer, uint8_t reader_descriptor);
 
 void
-initMultiReaderBuffer(MultiReaderBuffer *self, uint8_t word_size, size_t max_elements, size_t max_readers)
+initMultiReaderBuffer(MultiReaderBuffer *self, size_t word_size, size_t max_elements, size_t max_readers)
+{
+  initMultiReaderBufferWithOptions(self, word_size, max_elements, max_readers, MULTI_READER_BUFFER_DEFAULT_OPTIONS);
+}
+
+void
+initMultiReaderBufferWithOptions(MultiReaderBuffer *self, size_t word_size, size_t max_elements, size_t max_readers, MultiReaderBufferOptions options)
+{
+  if ((options & MULTI_READER_BUFFER_POWER_OF_TWO_CAPACITY) && (max_elements == 0 || (max_elements & (max_elements - 1)) != 0))
+  {
+    Throw(BUFFER_INVALID_CAPACITY_EXCEPTION);
+  }
+
+  self->word_size_in_byte = word_size;
+  self->max_elements = max_elements;
+  self->max_readers = max_readers;
+  self->options = options;
+  self->number_of_slots = (options & MULTI_READER_BUFFER_POWER_OF_TWO_CAPACITY) ? max_elements : max_elements + 1;
+
+  if (!(options & MULTI_READER_BUFFER_SKIP_ZEROING))
+  {
+    memset(bufferStorage(self), 0, self->word_size_in_byte * self->number_of_slots); // Set buffer content to 0
+  }
+
+  self->write = 0;
+  self->stored_elements = 0;
+  self->reserved_elements = 0;
+  self->number_of_active_readers = 0;
+  self->slowest_reader_position = 0;
+  self->number_of_notified_readers = 0;
+  self->next_sequence_number = 0;
+  self->durable_reader = max_readers;
+#if MULTI_READER_BUFFER_METRICS
+  self->pushed_elements = 0;
+  self->rejected_elements = 0;
+  self->max_fill = 0;
+#endif
+
+  memset(activeReaderBitmap(self), 0, (self->max_readers + 7) / 8);
+
+  for (size_t reader_index = 0; reader_index < self->max_readers; ++reader_index)
+  {
+    readerSlots(self)[reader_index].position = 0;  // All readers initially at start position
+    readerSlots(self)[reader_index].lost_elements = 0;
+    readerSlots(self)[reader_index].state = BUFFER_READER_INVALID; // All readers initially invalid
+    readerSlots(self)[reader_index].notification_threshold = 0;
+  }
+}
+
+BufferStatus
+pushToBuffer(Buffer *self, const void *data)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+
+  if (rejectsWhenFull(impl) && !slowestReaderHasRoomFor(impl, 1))
+  {
+#if MULTI_READER_BUFFER_METRICS
+    impl->rejected_elements++;
+#endif
+    return BUFFER_FULL;
+  }
+
+  spillItemsOfDurableReader(impl, 1);
+
+  /* With power-of-two capacity, overruns are detected when reading instead (see checkIfReaderIsUsable) */
+
+  if (!hasPowerOfTwoCapacity(impl))
+  {
+    moveReadersOverrunByElements(impl, 1);
+  }
+
+  memcpy(slotPointer(impl, impl->write), data, impl->word_size_in_byte);
+  impl->write = advancePosition(impl, impl->write, 1);
+  addStoredElements(impl, 1);
+  countPushedElements(impl, 1);
+  notifyReaders(impl);
+
+  return BUFFER_OK;
+}
+
+BufferStatus
+pushManyToBuffer(Buffer *self, const void *data, size_t count)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+  const uint8_t *source = (const uint8_t*) data;
+
+  if (rejectsWhenFull(impl) && !slowestReaderHasRoomFor(impl, count))
+  {
+#if MULTI_READER_BUFFER_METRICS
+    impl->rejected_elements += count;
+#endif
+    return BUFFER_FULL;
+  }
+
+  while (count > impl->max_elements && hasDurableReader(impl))
+  {
+    /* Push in portions, so the items of the burst that would be skipped reach the spill handler */
+
+    pushManyToBuffer(self, source, impl->max_elements);
+    source += impl->max_elements * impl->word_size_in_byte;
+    count -= impl->max_elements;
+  }
+
+  spillItemsOfDurableReader(impl, count);
+
+  if (!hasPowerOfTwoCapacity(impl))
+  {
+    moveReadersOverrunByElements(impl, count);
+  }
+
+  countPushedElements(impl, count);
+
+  if (count > impl->max_elements)
+  {
+    /* Older items of the burst would be overwritten by the newer ones anyway */
+
+    size_t skipped_elements = count - impl->max_elements;
+
+    source += skipped_elements * impl->word_size_in_byte;
+    impl->write = advancePosition(impl, impl->write, skipped_elements);
+    count = impl->max_elements;
+  }
+
+  size_t elements_until_wrap = impl->number_of_slots - slotIndex(impl, impl->write);
+  size_t first_chunk = (count < elements_until_wrap) ? count : elements_until_wrap;
+
+  memcpy(slotPointer(impl, impl->write), source, first_chunk * impl->word_size_in_byte);
+  memcpy(bufferStorage(impl), source + first_chunk * impl->word_size_in_byte, (count - first_chunk) * impl->word_size_in_byte);
+
+  impl->write = advancePosition(impl, impl->write, count);
+  addStoredElements(impl, count);
+  notifyReaders(impl);  // Once for the whole burst
+
+  return BUFFER_OK;
+}
+
+size_t
+getFreeSpaceOfBuffer(const Buffer *self)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+
+  if (impl->number_of_active_readers == 0)
+  {
+    return impl->max_elements;
+  }
+
+  refreshSlowestReader(impl);
+
+  size_t slowest_unread_elements = numberOfUnreadElements(impl, impl->slowest_reader_position);
+
+  if (slowest_unread_elements >= impl->max_elements)
+  {
+    return 0;  // Lapped readers (power-of-two capacity) lag behind by more than max_elements
+  }
+
+  return impl->max_elements - slowest_unread_elements;
+}
+
+void*
+reserveBufferSpace(Buffer *self, size_t requested_elements, size_t *reserved_elements)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+  size_t elements_until_wrap = impl->number_of_slots - slotIndex(impl, impl->write);
+
+  if (requested_elements > impl->max_elements)
+  {
+    requested_elements = impl->max_elements;
+  }
+
+  if (requested_elements > elements_until_wrap)
+  {
+    requested_elements = elements_until_wrap;
+  }
+
+  if (rejectsWhenFull(impl) && !slowestReaderHasRoomFor(impl, requested_elements))
+  {
+    requested_elements = getFreeSpaceOfBuffer(self);
+  }
+
+  spillItemsOfDurableReader(impl, requested_elements);
+
+  if (!hasPowerOfTwoCapacity(impl))
+  {
+    moveReadersOverrunByElements(impl, requested_elements);
+  }
+
+  impl->reserved_elements = requested_elements;
+  *reserved_elements = requested_elements;
+
+  return slotPointer(impl, impl->write);
+}
+
+void
+commitBufferSpace(Buffer *self, size_t number_of_elements)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+
+  if (number_of_elements > impl->reserved_elements)
+  {
+    Throw(BUFFER_INVALID_COMMIT_EXCEPTION);
+  }
+
+  impl->write = advancePosition(impl, impl->write, number_of_elements);
+  addStoredElements(impl, number_of_elements);
+  countPushedElements(impl, number_of_elements);
+  impl->reserved_elements = 0;
+  notifyReaders(impl);
+}
+
+const void*
+peekAtBufferWithReader(const Buffer *self, uint8_t reader_descriptor)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+
+  checkIfReadingIsPossible(impl, reader_descriptor);  // Can throw exceptions
+
+  return slotPointer(impl, readerSlots(impl)[reader_descriptor].position);
+}
+
+const void*
+popFromBufferWithReader(Buffer *self, uint8_t reader_descriptor)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+
+  checkIfReadingIsPossible(impl, reader_descriptor);  // Can throw exceptions
+
+  BufferReader *reader = readerSlots(impl) + reader_descriptor;
+  const void *return_value = slotPointer(impl, reader->position);
+  advanceReader(impl, reader, 1);
+
+  return return_value;
+}
+
+BufferStatus
+tryPeekAtBufferWithReader(const Buffer *self, uint8_t reader_descriptor, const void **item)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+  BufferStatus status = readingPossibility(impl, reader_descriptor);
+
+  if (status == BUFFER_OK)
+  {
+    *item = slotPointer(impl, readerSlots(impl)[reader_descriptor].position);
+  }
+
+  return status;
+}
+
+BufferStatus
+tryPopFromBufferWithReader(Buffer *self, uint8_t reader_descriptor, const void **item)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+  BufferStatus status = readingPossibility(impl, reader_descriptor);
+
+  if (status == BUFFER_OK)
+  {
+    BufferReader *reader = readerSlots(impl) + reader_descriptor;
+    *item = slotPointer(impl, reader->position);
+    advanceReader(impl, reader, 1);
+  }
+
+  return status;
+}
+
+size_t
+peekSpanWithReader(const Buffer *self, uint8_t reader_descriptor, BufferSpan *span)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+
+  checkIfReaderIsUsable(impl, reader_descriptor);  // Can throw exceptions
+
+  size_t reader_position = readerSlots(impl)[reader_descriptor].position;
+  size_t unread_elements = numberOfUnreadElements(impl, reader_position);
+  size_t elements_until_wrap = impl->number_of_slots - slotIndex(impl, reader_position);
+
+  span->first = slotPointer(impl, reader_position);
+  span->first_length = (unread_elements < elements_until_wrap) ? unread_elements : elements_until_wrap;
+  span->second = bufferStorage(impl);
+  span->second_length = unread_elements - span->first_length;
+
+  return unread_elements;
+}
+
+void
+consumeWithReader(Buffer *self, uint8_t reader_descriptor, size_t number_of_elements)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+
+  checkIfReaderIsUsable(impl, reader_descriptor);  // Can throw exceptions
+
+  BufferReader *reader = readerSlots(impl) + reader_descriptor;
+
+  if (number_of_elements > numberOfUnreadElements(impl, reader->position))
+  {
+    Throw(BUFFER_UNDERRUN_EXCEPTION);
+  }
+
+  advanceReader(impl, reader, number_of_elements);
+}
+
+uint8_t
+getNewBufferReaderDescriptor(Buffer *self)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+
+  for (size_t reader_slot = 0; reader_slot < impl->max_readers; ++reader_slot)
+  {
+    BufferReader *reader = readerSlots(impl) + reader_slot;
+
+    if (reader->state == BUFFER_READER_INVALID)
+    {
+      reader->state = BUFFER_READER_VALID;
+      reader->position = oldestPosition(impl);  // New readers start at the oldest item
+      reader->lost_elements = 0;
+      reader->notification_threshold = 0;
+#if MULTI_READER_BUFFER_METRICS
+      reader->consumed_elements = 0;
+      reader->dropped_elements = 0;
+      reader->max_lag = 0;
+#endif
+
+      if (impl->number_of_active_readers == 0
+          || numberOfUnreadElements(impl, reader->position) > numberOfUnreadElements(impl, impl->slowest_reader_position))
+      {
+        impl->slowest_reader_position = reader->position;
+      }
+
+      activeReaderBitmap(impl)[reader_slot / 8] |= (1 << (reader_slot % 8));
+      impl->number_of_active_readers++;
+      return reader_slot;
+    }
+  }
+
+  Throw(BUFFER_NO_FREE_READER_SLOTS_EXCEPTION);
+  return 0; // Should not be reached
+}
+
+bool
+readableItemExistsForReader(const Buffer *self, uint8_t reader_descriptor)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+
+  if (reader_descriptor < impl->max_readers && readerSlots(impl)[reader_descriptor].state != BUFFER_READER_INVALID)
+  {
+    if (readerSlots(impl)[reader_descriptor].position != impl->write)  // Equality would mean buffer is empty
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+size_t
+getNumberOfLostElementsForReader(const Buffer *self, uint8_t reader_descriptor)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+
+  if (reader_descriptor >= impl->max_readers)
+  {
+    Throw(BUFFER_INVALID_READER_EXCEPTION);
+  }
+
+  return readerSlots(impl)[reader_descriptor].lost_elements;
+}
+
+uint64_t
+getNextBufferSequenceNumber(const Buffer *self)
+{
+  return ((const MultiReaderBuffer*) self)->next_sequence_number;
+}
+
+uint64_t
+getBufferReaderSequenceNumber(const Buffer *self, uint8_t reader_descriptor)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+
+  if (reader_descriptor >= impl->max_readers || readerSlots(impl)[reader_descriptor].state == BUFFER_READER_INVALID)
+  {
+    Throw(BUFFER_INVALID_READER_EXCEPTION);
+  }
+
+  BufferReader *reader = readerSlots(impl) + reader_descriptor;
+  uint64_t unread_elements = numberOfUnreadElements(impl, reader->position);
+
+  if (!hasPowerOfTwoCapacity(impl) && reader->state == BUFFER_READER_OVERRUN)
+  {
+    /* Overrun readers have already been moved past their lost items when pushing */
+
+    unread_elements += reader->lost_elements;
+  }
+
+  return impl->next_sequence_number - unread_elements;
+}
+
+BufferStatus
+seekBufferReaderToSequenceNumber(Buffer *self, uint8_t reader_descriptor, uint64_t sequence_number)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+
+  if (reader_descriptor >= impl->max_readers || readerSlots(impl)[reader_descriptor].state == BUFFER_READER_INVALID)
+  {
+    return BUFFER_INVALID_READER;
+  }
+
+  if (sequence_number < oldestSequenceNumber(impl))
+  {
+    return BUFFER_EVICTED;
+  }
+
+  if (sequence_number > impl->next_sequence_number)
+  {
+    return BUFFER_EMPTY;
+  }
+
+  moveReaderToSequenceNumber(impl, readerSlots(impl) + reader_descriptor, sequence_number);
+  return BUFFER_OK;
+}
+
+uint64_t
+seekBufferReaderToOldest(Buffer *self, uint8_t reader_descriptor)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+  uint64_t sequence_number = oldestSequenceNumber(impl);
+
+  if (seekBufferReaderToSequenceNumber(self, reader_descriptor, sequence_number) != BUFFER_OK)
+  {
+    Throw(BUFFER_INVALID_READER_EXCEPTION);  // The only possible failure
+  }
+
+  return sequence_number;
+}
+
+uint64_t
+seekBufferReaderToNewest(Buffer *self, uint8_t reader_descriptor)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+  uint64_t sequence_number = (impl->stored_elements > 0) ? impl->next_sequence_number - 1 : impl->next_sequence_number;
+
+  if (seekBufferReaderToSequenceNumber(self, reader_descriptor, sequence_number) != BUFFER_OK)
+  {
+    Throw(BUFFER_INVALID_READER_EXCEPTION);  // The only possible failure
+  }
+
+  return sequence_number;
+}
+
+void
+setBufferSpillHandler(Buffer *self, uint8_t reader_descriptor, BufferSpillHandler handler, size_t batch_size)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+
+  if (reader_descriptor >= impl->max_readers || readerSlots(impl)[reader_descriptor].state == BUFFER_READER_INVALID)
+  {
+    Throw(BUFFER_INVALID_READER_EXCEPTION);
+  }
+
+  if (handler.function == NULL)
+  {
+    impl->durable_reader = impl->max_readers;
+    return;
+  }
+
+  impl->durable_reader = reader_descriptor;
+  impl->spill_handler = handler;
+  impl->spill_batch_size = (batch_size > impl->max_elements) ? impl->max_elements : batch_size;
+}
+
+void
+setBufferReaderNotification(Buffer *self, uint8_t reader_descriptor, GenericCallback callback, size_t threshold)
 {
-  self->word_size_in_byte = word_size;
-  self->max_elements = max_elements;
-  self->max_readers = max_readers;
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+
+  if (reader_descriptor >= impl->max_readers || readerSlots(impl)[reader_descriptor].state == BUFFER_READER_INVALID)
+  {
+    Throw(BUFFER_INVALID_READER_EXCEPTION);
+  }
 
-  self->start = (void*) (((uint8_t*) self) + sizeof(MultiReaderBuffer));
+  BufferReader *reader = readerSlots(impl) + reader_descriptor;
 
-  for (uint8_t byte_in_buffer = 0; byte_in_buffer < (self->word_size_in_byte * (self->max_elements + 1)); ++byte_in_buffer)
+  if (reader->notification_threshold != 0)
   {
-    *(((uint8_t*) self->start) + byte_in_buffer) = 0; // Set buffer content to 0
+    impl->number_of_notified_readers--;
   }
 
-  self->write = self->start;
+  if (threshold > impl->max_elements)
+  {
+    threshold = impl->max_elements;  // More items are never unread at once
+  }
 
-  self->readers = (void**) (((uint8_t*) self->start) + (self->word_size_in_byte * (self->max_elements + 1)));
-	self->reader_state_indicators = (BufferReaderState*) (self->readers + self->max_readers);
+  reader->notification = callback;
+  reader->notification_threshold = threshold;
+  reader->notification_sent = false;
 
-  for (uint8_t reader_index = 0; reader_index < self->max_readers; ++reader_index)
+  if (threshold != 0)
   {
-    *(self->readers + reader_index) = self->start;  // All readers initially at start position
-    *(self->reader_state_indicators + reader_index) = BUFFER_READER_INVALID; // All readers initially invalid
+    impl->number_of_notified_readers++;
   }
 }
 
+#if MULTI_READER_BUFFER_METRICS
 void
-pushToBuffer(Buffer *self, const void *data)
+getBufferMetrics(const Buffer *self, BufferMetrics *metrics)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+
+  for (size_t reader_slot = nextActiveReader(impl, 0); reader_slot < impl->max_readers; reader_slot = nextActiveReader(impl, reader_slot + 1))
+  {
+    recordReaderLag(impl, readerSlots(impl) + reader_slot);  // Include the current lag of readers that have not read for a while
+  }
+
+  metrics->pushed_elements = impl->pushed_elements;
+  metrics->rejected_elements = impl->rejected_elements;
+  metrics->max_fill = impl->max_fill;
+}
+
+void
+getBufferReaderMetrics(const Buffer *self, uint8_t reader_descriptor, BufferReaderMetrics *metrics)
 {
   MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
 
-  for (uint8_t reader_slot = 0; reader_slot < impl->max_readers; ++reader_slot)
+  if (reader_descriptor >= impl->max_readers || readerSlots(impl)[reader_descriptor].state == BUFFER_READER_INVALID)
   {
-    /* Check for all read pointers whether they need to be updated */
+    Throw(BUFFER_INVALID_READER_EXCEPTION);
+  }
+
+  BufferReader *reader = readerSlots(impl) + reader_descriptor;
+
+  recordReaderLag(impl, reader);
 
-    if ((impl->readers)[reader_slot] == nextWordPosition(impl, impl->write))
+  metrics->consumed_elements = reader->consumed_elements;
+  metrics->dropped_elements = reader->dropped_elements;
+  metrics->max_lag = reader->max_lag;
+  metrics->current_lag = unreadElementsStillStored(impl, reader);
+}
+#endif
+
+void
+deleteBufferReaderDescriptor(Buffer *self, uint8_t reader_descriptor)
+{
+  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+
+  if (reader_descriptor < impl->max_readers)
+  {
+    if (readerSlots(impl)[reader_descriptor].state != BUFFER_READER_INVALID)
     {
-      /* Write pointer has overrun a read pointer */
+      activeReaderBitmap(impl)[reader_descriptor / 8] &= ~(1 << (reader_descriptor % 8));
+      impl->number_of_active_readers--;
 
-      if ((impl->reader_state_indicators)[reader_slot] != BUFFER_READER_INVALID)
+      if (readerSlots(impl)[reader_descriptor].notification_threshold != 0)
       {
-        (impl->reader_state_indicators)[reader_slot] = BUFFER_READER_OVERRUN;
+        impl->number_of_notified_readers--;
       }
 
-      (impl->readers)[reader_slot] = nextWordPosition(impl, (impl->readers)[reader_slot]);
+      if (impl->durable_reader == reader_descriptor)
+      {
+        impl->durable_reader = impl->max_readers;
+      }
+      refreshSlowestReader(impl);
     }
+
+    readerSlots(impl)[reader_descriptor].state = BUFFER_READER_INVALID;
+  }
+  else
+  {
+    Throw(BUFFER_INVALID_READER_EXCEPTION);
+  }
+}
+
+/* Helper functions */
+
+void
+checkIfReadingIsPossible(MultiReaderBuffer *buffer, uint8_t reader_descriptor)
+{
+  BufferStatus status = readingPossibility(buffer, reader_descriptor);
+
+  if (status != BUFFER_OK)
+  {
+    Throw(status);  // Status values are identical to the exception ids
   }
+}
+
+void
+checkIfReaderIsUsable(MultiReaderBuffer *buffer, uint8_t reader_descriptor)
+{
+  BufferStatus status = readerUsability(buffer, reader_descriptor);
 
-  copyMemory(impl->write, data, impl->word_size_in_byte);
-  impl->write = nextWordPosition(impl, impl->write);
+  if (status != BUFFER_OK)
+  {
+    Throw(status);  // Status values are identical to the exception ids
+  }
 }
 
-const void*
-peekAtBufferWithReader(const Buffer *self, uint8_t reader_descriptor)
+BufferStatus
+readingPossibility(MultiReaderBuffer *buffer, uint8_t reader_descriptor)
 {
-  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+  BufferStatus status = readerUsability(buffer, reader_descriptor);
 
-  checkIfReadingIsPossible(impl, reader_descriptor);  // Can throw exceptions
+  if (status == BUFFER_OK && readerSlots(buffer)[reader_descriptor].position == buffer->write)
+  {
+    return BUFFER_EMPTY;
+  }
 
-  return (impl->readers)[reader_descriptor];
+  return status;
 }
 
-const void*
-popFromBufferWithReader(Buffer *self, uint8_t reader_descriptor)
+BufferStatus
+readerUsability(MultiReaderBuffer *buffer, uint8_t reader_descriptor)
 {
-  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+  if (reader_descriptor >= buffer->max_readers || readerSlots(buffer)[reader_descriptor].state == BUFFER_READER_INVALID)
+  {
+    return BUFFER_INVALID_READER;
+  }
 
-  checkIfReadingIsPossible(impl, reader_descriptor);  // Can throw exceptions
+  BufferReader *reader = readerSlots(buffer) + reader_descriptor;
 
-  void *return_value = (impl->readers)[reader_descriptor];
-  (impl->readers)[reader_descriptor] = nextWordPosition(impl, (impl->readers)[reader_descriptor]);
+  recordReaderLag(buffer, reader);
 
-  return return_value;
+  if (hasPowerOfTwoCapacity(buffer))
+  {
+    size_t unread_elements = numberOfUnreadElements(buffer, reader->position);
+    size_t readable_elements = buffer->max_elements - buffer->reserved_elements;  // Reserved slots are being overwritten
+
+    if (unread_elements > readable_elements)
+    {
+      /* The free-running positions tell exactly how many items have been overwritten */
+
+      markReaderOverrun(reader, unread_elements - readable_elements);
+    }
+  }
+
+  if (reader->state == BUFFER_READER_OVERRUN)
+  {
+    /*
+     * Enable subsequent reading operations by flagging reader as valid again
+     * and pointing it to the currently oldest buffer element
+     */
+
+    reader->state = BUFFER_READER_VALID;
+    reader->position = oldestPosition(buffer);
+
+    return BUFFER_OVERRUN;
+  }
+
+  return BUFFER_OK;
 }
 
-uint8_t 
-getNewBufferReaderDescriptor(Buffer *self)
+void
+moveReadersOverrunByElements(MultiReaderBuffer *buffer, size_t count)
 {
-  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+  if (buffer->number_of_active_readers == 0
+      || numberOfUnreadElements(buffer, buffer->slowest_reader_position) + count <= buffer->max_elements)
+  {
+    return;  // Common case, no reader is overrun
+  }
+
+  size_t oldest_position = positionBefore(buffer, advancePosition(buffer, buffer->write, count), buffer->max_elements);
+  size_t slowest_unread_elements = 0;
+  bool reader_has_been_overrun = false;
 
-  for (uint8_t reader_slot = 0; reader_slot < impl->max_readers; ++reader_slot)
+  for (size_t reader_slot = nextActiveReader(buffer, 0); reader_slot < buffer->max_readers; reader_slot = nextActiveReader(buffer, reader_slot + 1))
   {
-    if ((impl->reader_state_indicators)[reader_slot] == BUFFER_READER_INVALID)
+    /* A reader is overrun if its unread items plus the new items do not fit into the buffer */
+
+    BufferReader *reader = readerSlots(buffer) + reader_slot;
+    size_t unread_elements = numberOfUnreadElements(buffer, reader->position);
+
+    if (unread_elements + count > buffer->max_elements)
     {
-      (impl->reader_state_indicators)[reader_slot] = BUFFER_READER_VALID;
-      return reader_slot;
+      markReaderOverrun(reader, unread_elements + count - buffer->max_elements);
+      reader->position = oldest_position;
+      reader_has_been_overrun = true;
+    }
+    else if (unread_elements > slowest_unread_elements)
+    {
+      slowest_unread_elements = unread_elements;
+      buffer->slowest_reader_position = reader->position;  // Refresh the cache on the way
     }
   }
 
-  Throw(BUFFER_NO_FREE_READER_SLOTS_EXCEPTION);
-  return 0; // Should not be reached
+  if (reader_has_been_overrun)
+  {
+    buffer->slowest_reader_position = oldest_position;
+  }
 }
 
 bool
-readableItemExistsForReader(const Buffer *self, uint8_t reader_descriptor)
+slowestReaderHasRoomFor(MultiReaderBuffer *buffer, size_t count)
 {
-  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+  /*
+   * The cached slowest position may be outdated since readers advance on their own,
+   * but it never underestimates the lag, so it only needs refreshing if it reports a lack of room
+   */
+
+  if (buffer->number_of_active_readers == 0
+      || numberOfUnreadElements(buffer, buffer->slowest_reader_position) + count <= buffer->max_elements)
+  {
+    return true;
+  }
+
+  refreshSlowestReader(buffer);
+
+  return numberOfUnreadElements(buffer, buffer->slowest_reader_position) + count <= buffer->max_elements;
+}
+
+void
+refreshSlowestReader(MultiReaderBuffer *buffer)
+{
+  size_t slowest_unread_elements = 0;
+
+  buffer->slowest_reader_position = buffer->write;
+
+  for (size_t reader_slot = nextActiveReader(buffer, 0); reader_slot < buffer->max_readers; reader_slot = nextActiveReader(buffer, reader_slot + 1))
+  {
+    size_t unread_elements = numberOfUnreadElements(buffer, readerSlots(buffer)[reader_slot].position);
+
+    if (unread_elements > slowest_unread_elements)
+    {
+      slowest_unread_elements = unread_elements;
+      buffer->slowest_reader_position = readerSlots(buffer)[reader_slot].position;
+    }
+  }
+}
 
-  if (reader_descriptor < impl->max_readers && (impl->reader_state_indicators)[reader_descriptor] != BUFFER_READER_INVALID)
+size_t
+nextActiveReader(const MultiReaderBuffer *buffer, size_t reader_slot)
+{
+  while (reader_slot < buffer->max_readers)
   {
-    if ((impl->readers)[reader_descriptor] != impl->write)  // Equality would mean buffer is empty
+    uint8_t active_bits = activeReaderBitmap(buffer)[reader_slot / 8] >> (reader_slot % 8);
+
+    if (active_bits == 0)
     {
-      return true;
+      reader_slot = (reader_slot / 8 + 1) * 8;  // Skip the rest of a byte without active readers
+      continue;
+    }
+
+    while (!(active_bits & 0x01))
+    {
+      active_bits >>= 1;
+      ++reader_slot;
     }
+
+    return reader_slot;
   }
 
-  return false;
+  return buffer->max_readers;
 }
 
 void
-deleteBufferReaderDescriptor(Buffer *self, uint8_t reader_descriptor)
+markReaderOverrun(BufferReader *reader, size_t lost_elements)
 {
-  MultiReaderBuffer *impl = (MultiReaderBuffer*) self;
+#if MULTI_READER_BUFFER_METRICS
+  reader->dropped_elements += lost_elements;
+#endif
 
-  if (reader_descriptor < impl->max_readers)
+  if (reader->state == BUFFER_READER_OVERRUN)
   {
-    (impl->reader_state_indicators)[reader_descriptor] = BUFFER_READER_INVALID;
+    reader->lost_elements += lost_elements;
   }
   else
   {
-    Throw(BUFFER_INVALID_READER_EXCEPTION);
+    reader->state = BUFFER_READER_OVERRUN;
+    reader->lost_elements = lost_elements;
   }
 }
 
-/* Helper functions */
+void
+advanceReader(MultiReaderBuffer *buffer, BufferReader *reader, size_t count)
+{
+  reader->position = advancePosition(buffer, reader->position, count);
+  reader->notification_sent = false;  // Reading re-enables the notification
+  countConsumedElements(reader, count);
+}
+
+bool
+hasDurableReader(const MultiReaderBuffer *buffer)
+{
+  return buffer->durable_reader < buffer->max_readers;
+}
 
 void
-checkIfReadingIsPossible(MultiReaderBuffer *buffer, uint8_t reader_descriptor)
+spillItemsOfDurableReader(MultiReaderBuffer *buffer, size_t count)
 {
-  if (reader_descriptor >= buffer->max_readers || (buffer->reader_state_indicators)[reader_descriptor] == BUFFER_READER_INVALID)
+  if (!hasDurableReader(buffer))
   {
-    Throw(BUFFER_INVALID_READER_EXCEPTION);
+    return;  // Common case, nothing to spill
   }
 
-  if ((buffer->reader_state_indicators)[reader_descriptor] == BUFFER_READER_OVERRUN)
+  BufferReader *reader = readerSlots(buffer) + buffer->durable_reader;
+  size_t unread_elements = numberOfUnreadElements(buffer, reader->position);
+
+  if (unread_elements + count <= buffer->max_elements || unread_elements > buffer->max_elements)
   {
-    /* 
-     * Enable subsequent reading operations by flagging reader as valid again
-     * and pointing it to the currently oldest buffer element
-     */
+    return;  // Nothing would be overwritten, or the reader has been lapped before it became durable
+  }
 
-    (buffer->reader_state_indicators)[reader_descriptor] = BUFFER_READER_VALID;
-    (buffer->readers)[reader_descriptor] = nextWordPosition(buffer, buffer->write);
+  size_t spilled_elements = unread_elements + count - buffer->max_elements;
 
-    Throw(BUFFER_OVERRUN_EXCEPTION);
+  if (spilled_elements < buffer->spill_batch_size)
+  {
+    spilled_elements = buffer->spill_batch_size;
   }
 
-  if ((buffer->readers)[reader_descriptor] == buffer->write)
+  if (spilled_elements > unread_elements)
   {
-    Throw(BUFFER_UNDERRUN_EXCEPTION);
+    spilled_elements = unread_elements;
+  }
+
+  size_t elements_until_wrap = buffer->number_of_slots - slotIndex(buffer, reader->position);
+  size_t first_chunk = (spilled_elements < elements_until_wrap) ? spilled_elements : elements_until_wrap;
+
+  buffer->spill_handler.function(buffer->spill_handler.argument, slotPointer(buffer, reader->position), first_chunk);
+
+  if (spilled_elements > first_chunk)
+  {
+    buffer->spill_handler.function(buffer->spill_handler.argument, bufferStorage(buffer), spilled_elements - first_chunk);
+  }
+
+  reader->position = advancePosition(buffer, reader->position, spilled_elements);
+}
+
+void
+notifyReaders(MultiReaderBuffer *buffer)
+{
+  if (buffer->number_of_notified_readers == 0)
+  {
+    return;  // Common case, nobody to notify
+  }
+
+  for (size_t reader_slot = nextActiveReader(buffer, 0); reader_slot < buffer->max_readers; reader_slot = nextActiveReader(buffer, reader_slot + 1))
+  {
+    BufferReader *reader = readerSlots(buffer) + reader_slot;
+
+    if (reader->notification_threshold != 0 && !reader->notification_sent
+        && numberOfUnreadElements(buffer, reader->position) >= reader->notification_threshold)
+    {
+      reader->notification_sent = true;  // Set before the call, the callback may push itself
+      reader->notification.function(reader->notification.argument);
+    }
+  }
+}
+
+void
+countPushedElements(MultiReaderBuffer *buffer, size_t count)
+{
+  buffer->next_sequence_number += count;
+#if MULTI_READER_BUFFER_METRICS
+  buffer->pushed_elements += count;
+#endif
+}
+
+void
+countConsumedElements(BufferReader *reader, size_t count)
+{
+#if MULTI_READER_BUFFER_METRICS
+  reader->consumed_elements += count;
+#else
+  (void) reader;
+  (void) count;
+#endif
+}
+
+void
+recordReaderLag(MultiReaderBuffer *buffer, BufferReader *reader)
+{
+#if MULTI_READER_BUFFER_METRICS
+  /* Lag only grows between two reads, so its maximum is reached right before a read */
+
+  size_t lag = unreadElementsStillStored(buffer, reader);
+
+  if (lag > reader->max_lag)
+  {
+    reader->max_lag = lag;
+  }
+
+  if (lag > buffer->max_fill)
+  {
+    buffer->max_fill = lag;
+  }
+#else
+  (void) buffer;
+  (void) reader;
+#endif
+}
+
+#if MULTI_READER_BUFFER_METRICS
+size_t
+unreadElementsStillStored(MultiReaderBuffer *buffer, BufferReader *reader)
+{
+  /* Readers lapped with power-of-two capacity lag behind by more than max_elements until their next read */
+
+  size_t unread_elements = numberOfUnreadElements(buffer, reader->position);
+
+  return (unread_elements > buffer->max_elements) ? buffer->max_elements : unread_elements;
+}
+#endif
+
+void
+addStoredElements(MultiReaderBuffer *buffer, size_t count)
+{
+  if (count >= buffer->max_elements - buffer->stored_elements)
+  {
+    buffer->stored_elements = buffer->max_elements;
+  }
+  else
+  {
+    buffer->stored_elements += count;
   }
 }
 
+uint64_t
+oldestSequenceNumber(const MultiReaderBuffer *buffer)
+{
+  return buffer->next_sequence_number - buffer->stored_elements;
+}
+
 void
-copyMemory(void *destination, const void *source, uint8_t number_of_bytes)
+moveReaderToSequenceNumber(MultiReaderBuffer *buffer, BufferReader *reader, uint64_t sequence_number)
+{
+  /* Held items have consecutive sequence numbers, so the distance to the newest one gives the position */
+
+  reader->position = positionBefore(buffer, buffer->write, (size_t) (buffer->next_sequence_number - sequence_number));
+  reader->state = BUFFER_READER_VALID;  // An explicit seek replaces the jump to the oldest item after an overrun
+  reader->notification_sent = false;
+
+  if (numberOfUnreadElements(buffer, reader->position) > numberOfUnreadElements(buffer, buffer->slowest_reader_position))
+  {
+    buffer->slowest_reader_position = reader->position;  // Seeking backwards can make the reader the slowest one
+  }
+}
+
+size_t
+oldestPosition(const MultiReaderBuffer *buffer)
+{
+  /* Items in the slots of an open reservation are no longer readable */
+
+  size_t readable_elements = buffer->max_elements - buffer->reserved_elements;
+
+  if (buffer->stored_elements < readable_elements)
+  {
+    readable_elements = buffer->stored_elements;
+  }
+
+  return positionBefore(buffer, buffer->write, readable_elements);
+}
+
+size_t
+numberOfUnreadElements(const MultiReaderBuffer *buffer, size_t reader_position)
+{
+  if (hasPowerOfTwoCapacity(buffer) || buffer->write >= reader_position)
+  {
+    return buffer->write - reader_position;
+  }
+
+  return buffer->number_of_slots - reader_position + buffer->write;
+}
+
+size_t
+advancePosition(const MultiReaderBuffer *buffer, size_t position, size_t count)
+{
+  if (hasPowerOfTwoCapacity(buffer))
+  {
+    return position + count;  // Free-running, wraps around together with the slot index
+  }
+
+  if (count >= buffer->number_of_slots)
+  {
+    count %= buffer->number_of_slots;
+  }
+
+  position += count;
+
+  if (position >= buffer->number_of_slots)
+  {
+    position -= buffer->number_of_slots;
+  }
+
+  return position;
+}
+
+size_t
+positionBefore(const MultiReaderBuffer *buffer, size_t position, size_t count)
 {
-  while (number_of_bytes > 0)
+  if (hasPowerOfTwoCapacity(buffer) || position >= count)
   {
-    *((uint8_t*) destination++) = *((uint8_t*) source++);
-    --number_of_bytes;
+    return position - count;
   }
+
+  return position + buffer->number_of_slots - count;
+}
+
+BufferReader*
+readerSlots(const MultiReaderBuffer *buffer)
+{
+  return (BufferReader*) (buffer + 1);
+}
+
+uint8_t*
+bufferStorage(const MultiReaderBuffer *buffer)
+{
+  return (uint8_t*) (readerSlots(buffer) + buffer->max_readers);
+}
+
+uint8_t*
+activeReaderBitmap(const MultiReaderBuffer *buffer)
+{
+  return bufferStorage(buffer) + buffer->word_size_in_byte * buffer->number_of_slots;
 }
 
 void*
-nextWordPosition(MultiReaderBuffer *buffer, void *pointer)
+slotPointer(const MultiReaderBuffer *buffer, size_t position)
 {
-  pointer += buffer->word_size_in_byte;
+  return bufferStorage(buffer) + slotIndex(buffer, position) * buffer->word_size_in_byte;
+}
 
-  if (pointer >= buffer->start + (buffer->word_size_in_byte * (buffer->max_elements + 1)))
+size_t
+slotIndex(const MultiReaderBuffer *buffer, size_t position)
+{
+  if (hasPowerOfTwoCapacity(buffer))
   {
-    pointer = buffer->start;
+    return position & (buffer->max_elements - 1);
   }
 
-  return pointer;
+  return position;
+}
+
+bool
+rejectsWhenFull(const MultiReaderBuffer *buffer)
+{
+  /* Blocking is only possible if another thread can advance the readers, so it falls back to rejecting here */
+
+  return buffer->options & (MULTI_READER_BUFFER_REJECT_WHEN_FULL | MULTI_READER_BUFFER_BLOCK_WHEN_FULL);
+}
+
+bool
+hasPowerOfTwoCapacity(const MultiReaderBuffer *buffer)
+{
+  return buffer->options & MULTI_READER_BUFFER_POWER_OF_TWO_CAPACITY;
 }
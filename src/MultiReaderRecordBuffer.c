@@ -0,0 +1,303 @@
+#include "EmbeddedUtilities/MultiReaderRecordBuffer.h"
+#include "CException.h"
+#include <string.h>
+
+#define WRAP_MARKER (0xFFFF)  // Stored instead of a length where the next record continues at the start of the memory
+
+/**
+ *  Helper function
+ */
+static RecordBufferReader*
+readerSlots(const MultiReaderRecordBuffer *buffer);
+
+/**
+ *  Helper function
+ */
+static uint8_t*
+bufferStorage(const MultiReaderRecordBuffer *buffer);
+
+/**
+ *  Helper function
+ */
+static size_t
+bytesUntilWrap(const MultiReaderRecordBuffer *buffer, size_t position);
+
+/**
+ *  Helper function
+ */
+static uint16_t
+readHeader(const MultiReaderRecordBuffer *buffer, size_t position);
+
+/**
+ *  Helper function
+ */
+static size_t
+skipWrapMarker(const MultiReaderRecordBuffer *buffer, size_t position);
+
+/**
+ *  Helper function
+ */
+static void
+dropOldestRecordsUntilFree(MultiReaderRecordBuffer *buffer, size_t number_of_bytes);
+
+/**
+ *  Helper function
+ */
+static BufferStatus
+readingPossibility(MultiReaderRecordBuffer *buffer, uint8_t reader_descriptor);
+
+/**
+ *  Helper function
+ */
+static const void*
+readRecord(MultiReaderRecordBuffer *buffer, uint8_t reader_descriptor, size_t *length, bool advance);
+
+void
+initMultiReaderRecordBuffer(MultiReaderRecordBuffer *self, size_t max_bytes, size_t max_readers)
+{
+  if (max_bytes == 0 || (max_bytes & (max_bytes - 1)) != 0)
+  {
+    Throw(BUFFER_INVALID_CAPACITY_EXCEPTION);
+  }
+
+  self->max_bytes = max_bytes;
+  self->max_readers = max_readers;
+  self->write = 0;
+  self->oldest = 0;
+  self->oldest_record = 0;
+
+  for (size_t reader_slot = 0; reader_slot < max_readers; ++reader_slot)
+  {
+    readerSlots(self)[reader_slot].position = 0;
+    readerSlots(self)[reader_slot].record = 0;
+    readerSlots(self)[reader_slot].lost_records = 0;
+    readerSlots(self)[reader_slot].state = BUFFER_READER_INVALID;
+  }
+}
+
+void
+pushRecord(MultiReaderRecordBuffer *self, const void *data, size_t length)
+{
+  if (length > MULTI_READER_RECORD_BUFFER_MAX_RECORD_LENGTH(self->max_bytes) || length >= WRAP_MARKER)
+  {
+    Throw(BUFFER_INVALID_RECORD_LENGTH_EXCEPTION);
+  }
+
+  size_t record_size = MULTI_READER_RECORD_BUFFER_HEADER_SIZE + length;
+  size_t padding = 0;
+
+  if (bytesUntilWrap(self, self->write) < record_size)
+  {
+    padding = bytesUntilWrap(self, self->write);  // Record does not fit before the end of the memory
+  }
+
+  dropOldestRecordsUntilFree(self, padding + record_size);
+
+  if (padding >= MULTI_READER_RECORD_BUFFER_HEADER_SIZE)
+  {
+    uint16_t marker = WRAP_MARKER;
+    memcpy(bufferStorage(self) + (self->write & (self->max_bytes - 1)), &marker, MULTI_READER_RECORD_BUFFER_HEADER_SIZE);
+  }
+
+  self->write += padding;
+
+  uint8_t *destination = bufferStorage(self) + (self->write & (self->max_bytes - 1));
+  uint16_t header = length;
+
+  memcpy(destination, &header, MULTI_READER_RECORD_BUFFER_HEADER_SIZE);
+  memcpy(destination + MULTI_READER_RECORD_BUFFER_HEADER_SIZE, data, length);
+
+  self->write += record_size;
+}
+
+uint8_t
+getNewRecordBufferReaderDescriptor(MultiReaderRecordBuffer *self)
+{
+  for (size_t reader_slot = 0; reader_slot < self->max_readers; ++reader_slot)
+  {
+    RecordBufferReader *reader = readerSlots(self) + reader_slot;
+
+    if (reader->state == BUFFER_READER_INVALID)
+    {
+      reader->state = BUFFER_READER_VALID;
+      reader->position = self->oldest;  // New readers start at the oldest record
+      reader->record = self->oldest_record;
+      reader->lost_records = 0;
+      return reader_slot;
+    }
+  }
+
+  Throw(BUFFER_NO_FREE_READER_SLOTS_EXCEPTION);
+  return 0; // Should not be reached
+}
+
+void
+deleteRecordBufferReaderDescriptor(MultiReaderRecordBuffer *self, uint8_t reader_descriptor)
+{
+  if (reader_descriptor >= self->max_readers)
+  {
+    Throw(BUFFER_INVALID_READER_EXCEPTION);
+  }
+
+  readerSlots(self)[reader_descriptor].state = BUFFER_READER_INVALID;
+}
+
+bool
+readableRecordExistsForReader(const MultiReaderRecordBuffer *self, uint8_t reader_descriptor)
+{
+  return reader_descriptor < self->max_readers
+    && readerSlots(self)[reader_descriptor].state != BUFFER_READER_INVALID
+    && readerSlots(self)[reader_descriptor].position != self->write;
+}
+
+const void*
+peekRecordWithReader(MultiReaderRecordBuffer *self, uint8_t reader_descriptor, size_t *length)
+{
+  BufferStatus status = readingPossibility(self, reader_descriptor);
+
+  if (status != BUFFER_OK)
+  {
+    Throw(status);  // Status values are identical to the exception ids
+  }
+
+  return readRecord(self, reader_descriptor, length, false);
+}
+
+const void*
+popRecordWithReader(MultiReaderRecordBuffer *self, uint8_t reader_descriptor, size_t *length)
+{
+  BufferStatus status = readingPossibility(self, reader_descriptor);
+
+  if (status != BUFFER_OK)
+  {
+    Throw(status);  // Status values are identical to the exception ids
+  }
+
+  return readRecord(self, reader_descriptor, length, true);
+}
+
+BufferStatus
+tryPopRecordWithReader(MultiReaderRecordBuffer *self, uint8_t reader_descriptor, const void **record, size_t *length)
+{
+  BufferStatus status = readingPossibility(self, reader_descriptor);
+
+  if (status == BUFFER_OK)
+  {
+    *record = readRecord(self, reader_descriptor, length, true);
+  }
+
+  return status;
+}
+
+size_t
+getNumberOfLostRecordsForReader(const MultiReaderRecordBuffer *self, uint8_t reader_descriptor)
+{
+  if (reader_descriptor >= self->max_readers)
+  {
+    Throw(BUFFER_INVALID_READER_EXCEPTION);
+  }
+
+  return readerSlots(self)[reader_descriptor].lost_records;
+}
+
+/* Helper functions */
+
+BufferStatus
+readingPossibility(MultiReaderRecordBuffer *buffer, uint8_t reader_descriptor)
+{
+  if (reader_descriptor >= buffer->max_readers || readerSlots(buffer)[reader_descriptor].state == BUFFER_READER_INVALID)
+  {
+    return BUFFER_INVALID_READER;
+  }
+
+  RecordBufferReader *reader = readerSlots(buffer) + reader_descriptor;
+
+  if (buffer->write - reader->position > buffer->write - buffer->oldest)
+  {
+    /* The reader lags behind the oldest record, so it continues there */
+
+    reader->lost_records = buffer->oldest_record - reader->record;
+    reader->position = buffer->oldest;
+    reader->record = buffer->oldest_record;
+
+    return BUFFER_OVERRUN;
+  }
+
+  if (reader->position == buffer->write)
+  {
+    return BUFFER_EMPTY;
+  }
+
+  return BUFFER_OK;
+}
+
+const void*
+readRecord(MultiReaderRecordBuffer *buffer, uint8_t reader_descriptor, size_t *length, bool advance)
+{
+  RecordBufferReader *reader = readerSlots(buffer) + reader_descriptor;
+
+  reader->position = skipWrapMarker(buffer, reader->position);
+  *length = readHeader(buffer, reader->position);
+
+  const uint8_t *record = bufferStorage(buffer) + (reader->position & (buffer->max_bytes - 1)) + MULTI_READER_RECORD_BUFFER_HEADER_SIZE;
+
+  if (advance)
+  {
+    reader->position += MULTI_READER_RECORD_BUFFER_HEADER_SIZE + *length;
+    reader->record++;
+  }
+
+  return record;
+}
+
+void
+dropOldestRecordsUntilFree(MultiReaderRecordBuffer *buffer, size_t number_of_bytes)
+{
+  /* Readers still pointing to dropped records notice on their next read (see readingPossibility) */
+
+  while (buffer->write + number_of_bytes - buffer->oldest > buffer->max_bytes)
+  {
+    buffer->oldest = skipWrapMarker(buffer, buffer->oldest);
+    buffer->oldest += MULTI_READER_RECORD_BUFFER_HEADER_SIZE + readHeader(buffer, buffer->oldest);
+    buffer->oldest_record++;
+  }
+}
+
+size_t
+skipWrapMarker(const MultiReaderRecordBuffer *buffer, size_t position)
+{
+  size_t bytes_until_wrap = bytesUntilWrap(buffer, position);
+
+  if (bytes_until_wrap < MULTI_READER_RECORD_BUFFER_HEADER_SIZE || readHeader(buffer, position) == WRAP_MARKER)
+  {
+    return position + bytes_until_wrap;
+  }
+
+  return position;
+}
+
+uint16_t
+readHeader(const MultiReaderRecordBuffer *buffer, size_t position)
+{
+  uint16_t header;
+  memcpy(&header, bufferStorage(buffer) + (position & (buffer->max_bytes - 1)), MULTI_READER_RECORD_BUFFER_HEADER_SIZE);
+  return header;
+}
+
+size_t
+bytesUntilWrap(const MultiReaderRecordBuffer *buffer, size_t position)
+{
+  return buffer->max_bytes - (position & (buffer->max_bytes - 1));
+}
+
+uint8_t*
+bufferStorage(const MultiReaderRecordBuffer *buffer)
+{
+  return (uint8_t*) (readerSlots(buffer) + buffer->max_readers);
+}
+
+RecordBufferReader*
+readerSlots(const MultiReaderRecordBuffer *buffer)
+{
+  return (RecordBufferReader*) (buffer + 1);
+}
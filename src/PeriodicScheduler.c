@@ -4,48 +4,49 @@
 
 PeriodicScheduler *
 createPeriodicScheduler(void   *memory,
-                        uint8_t maximum_number_of_tasks)
+                        TaskId  maximum_number_of_tasks)
 {
   PeriodicScheduler *returned_scheduler = (PeriodicScheduler *) memory;
 
   // removing const here is okay since the memory area does not hold a const
   // object but raw memory either allocated on stack via an array definition or
   // by malloc
-  *(uint8_t *)&returned_scheduler->limit = maximum_number_of_tasks;
+  *(TaskId *)&returned_scheduler->limit = maximum_number_of_tasks;
 
   returned_scheduler->tasks        = memory + sizeof(PeriodicScheduler);
-  for (uint8_t i = 0; i < maximum_number_of_tasks; i++)
+  returned_scheduler->heap         =
+    (TaskId *) (returned_scheduler->tasks + maximum_number_of_tasks);
+  returned_scheduler->number_of_tasks = 0;
+  returned_scheduler->tick_counter = 0;
+  returned_scheduler->catch_up     = false;
+#if PERIODIC_SCHEDULER_PROFILING
+  returned_scheduler->timestamp    = NULL;
+#endif
+  for (TaskId i = 0; i < maximum_number_of_tasks; i++)
     {
       returned_scheduler->tasks[i].is_valid = false;
     }
   return ((PeriodicScheduler *) memory);
 }
 
-uint8_t
+TaskId
 getNumberOfFreeSlotsInSchedule(const PeriodicScheduler *self)
 {
-  uint8_t number_of_invalid_tasks = 0;
-  for (uint8_t index = 0; index < self->limit; index++)
-  {
-    if (!self->tasks[index].is_valid)
-    {
-      number_of_invalid_tasks++;
-    }
-  }
-  return number_of_invalid_tasks;
+  return self->limit - self->number_of_tasks;
 }
 
 size_t
-getSchedulersRequiredMemorySize(uint8_t task_limit)
+getSchedulersRequiredMemorySize(TaskId task_limit)
 {
-  return task_limit * sizeof(InternalTask) + sizeof(PeriodicScheduler);
+  return task_limit * (sizeof(InternalTask) + sizeof(TaskId))
+    + sizeof(PeriodicScheduler);
 }
 
-uint8_t
+TaskId
 addTaskToScheduler(PeriodicScheduler *self,
                    const Task        *task)
 {
-    uint8_t index = 0;
+    TaskId index = 0;
     while (index < self->limit && self->tasks[index].is_valid)
       {
 	index++;
@@ -58,7 +59,15 @@ addTaskToScheduler(PeriodicScheduler *self,
       {
 	self->tasks[index].task     = *task;
 	self->tasks[index].is_valid = true;
-	resetTask(&self->tasks[index].task);
+	self->tasks[index].timing   = PERIODIC_SCHEDULER_FIXED_DELAY;
+	self->tasks[index].missed_periods = 0;
+#if PERIODIC_SCHEDULER_PROFILING
+	self->tasks[index].profile = (TaskProfile) {
+	  .min_execution_time = UINT32_MAX,
+	};
+#endif
+	resetTask(&self->tasks[index], readTickCounter(self));
+	insertIntoHeap(self, index);
 	debug(String, "added task number ");
 	debug(UInt16, index);
 	debug(String, "\n");
@@ -66,7 +75,7 @@ addTaskToScheduler(PeriodicScheduler *self,
     return index;
 }
 
-uint8_t
+TaskId
 scheduleTaskPeriodically(PeriodicScheduler *self,
                          const Task        *task)
 {
@@ -77,73 +86,365 @@ void
 updateScheduledTasks(PeriodicScheduler *self,
                      Ticks number_of_ticks)
 {
-  for (uint8_t i = 0; i < self->limit; i++)
+  self->tick_counter += number_of_ticks;
+}
+
+TickCount
+getTicksUntilNextDueTask(const PeriodicScheduler *self)
+{
+  if (self->number_of_tasks == 0)
     {
-      if (self->tasks[i].is_valid)
-	{
-	  ((Task*) (self->tasks + i))->ticks_elapsed += number_of_ticks;
-	}
+      return PERIODIC_SCHEDULER_NO_TASK_DUE;
+    }
+  int32_t remaining_ticks =
+    (int32_t) (self->tasks[self->heap[0]].next_due - readTickCounter(self));
+  return (remaining_ticks > 0) ? (TickCount) remaining_ticks : 0;
+}
+
+void
+setSchedulerCatchUp(PeriodicScheduler *self,
+                    bool               enabled)
+{
+  self->catch_up = enabled;
+}
+
+void
+setTaskTiming(PeriodicScheduler *self,
+              TaskId             id,
+              TaskTiming         timing)
+{
+  getValidTask(self, id)->timing = timing;
+}
+
+uint32_t
+getNumberOfMissedPeriods(const PeriodicScheduler *self,
+                         TaskId                   id)
+{
+  return getValidTask(self, id)->missed_periods;
+}
+
+#if PERIODIC_SCHEDULER_PROFILING
+void
+setSchedulerTimestampSource(PeriodicScheduler *self,
+                            uint32_t (*timestamp)(void))
+{
+  self->timestamp = timestamp;
+}
+
+void
+getTaskProfile(const PeriodicScheduler *self,
+               TaskId                   id,
+               TaskProfile             *profile)
+{
+  *profile = getValidTask(self, id)->profile;
+  if (profile->number_of_executions == 0)
+    {
+      profile->min_execution_time = 0;
+      return;
     }
+  profile->mean_execution_time =
+    (uint32_t) (profile->total_execution_time / profile->number_of_executions);
+  profile->mean_release_jitter =
+    (TickCount) (profile->total_release_jitter / profile->number_of_executions);
 }
+#endif
 
 void
 processScheduledTasks(PeriodicScheduler *self)
 {
-  for (uint8_t i = 0; i < self->limit; i++)
+  // the task with the earliest deadline is at the top of the heap,
+  // so the pass stops at the first task that is not due yet
+  TickCount now = readTickCounter(self);
+  while (self->number_of_tasks > 0
+         && taskIsDue(self->tasks + self->heap[0], now))
     {
-      executeTaskIfDue(self->tasks, i);
+      executeTask(self, self->heap[0], now);
     }
 }
 
 void
 removeAllTasksFromSchedule(PeriodicScheduler *self)
 {
-  for (uint8_t index = 0; index < self->limit; index++)
+  for (TaskId index = 0; index < self->limit; index++)
   {
     self->tasks[index].is_valid = false;
   }
+  self->number_of_tasks = 0;
 }
 
 void
-executeTaskIfDue(InternalTask *tasks,
-                 uint8_t       index)
+executeTask(PeriodicScheduler *self,
+            TaskId             index,
+            TickCount          now)
 {
-  Task *task = (Task *) (tasks + index);
-  if (task->ticks_elapsed >= task->period && ((InternalTask *) task)->is_valid)
+  InternalTask *task = self->tasks + index;
+  bool execute = true;
+  TickCount release = releaseOfDueInstance(self, task, now, &execute);
+  if (execute)
     {
       debug(String, "executing task ");
       debug(UInt16, index);
       debug(String, "\n");
-      task->function(task->argument);
-      resetTask(task);
+#if PERIODIC_SCHEDULER_PROFILING
+      TickCount start_tick = readTickCounter(self);
+      uint32_t start_time = readTimestamp(self);
+#endif
+      task->task.function(task->task.argument);
+#if PERIODIC_SCHEDULER_PROFILING
+      if (task->is_valid)
+	{
+	  recordExecution(self, task, start_tick, start_time);
+	}
+#endif
+    }
+  // the task may have removed itself
+  if (task->is_valid)
+    {
+      resetTask(task, release);
+      restoreHeapOrder(self, index);
     }
 }
 
+TickCount
+releaseOfDueInstance(const PeriodicScheduler *self,
+                     InternalTask            *task,
+                     TickCount                now,
+                     bool                    *execute)
+{
+  // returns the tick the period following this execution is counted
+  // from and adds the instances that have been missed meanwhile
+  Ticks period = taskPeriod(task);
+  TickCount lateness = now - task->next_due;
+  TickCount overdue_periods = (lateness < period) ? 0 : lateness / period;
+  TaskTiming timing = task->timing;
+  if (timing == PERIODIC_SCHEDULER_FIXED_DELAY && self->catch_up)
+    {
+      timing = PERIODIC_SCHEDULER_FIXED_RATE_RUN_ALL;
+    }
+  switch (timing)
+    {
+    case PERIODIC_SCHEDULER_FIXED_RATE_RUN_ALL:
+      // the following instances are still due and executed
+      // in the same pass, each of them counts itself
+      task->missed_periods += (overdue_periods > 0) ? 1 : 0;
+      return task->next_due;
+    case PERIODIC_SCHEDULER_FIXED_RATE_COALESCE:
+      // the latest of the merged instances is executed
+      task->missed_periods += overdue_periods;
+      task->next_due += overdue_periods * period;
+      return task->next_due;
+    case PERIODIC_SCHEDULER_FIXED_RATE_SKIP:
+      if (overdue_periods > 0)
+	{
+	  *execute = false;
+	  task->missed_periods += overdue_periods + 1;
+	}
+      return task->next_due + overdue_periods * period;
+    default:
+      task->missed_periods += overdue_periods;
+      return now;
+    }
+}
+
+#if PERIODIC_SCHEDULER_PROFILING
 void
-resetTask(Task *task)
+recordExecution(const PeriodicScheduler *self,
+                InternalTask            *task,
+                TickCount                start_tick,
+                uint32_t                 start_time)
+{
+  // next_due still holds the deadline of the executed instance
+  TaskProfile *profile = &task->profile;
+  uint32_t execution_time = readTimestamp(self) - start_time;
+  TickCount release_jitter = start_tick - task->next_due;
+  TickCount completion = readTickCounter(self) - task->next_due;
+  profile->number_of_executions++;
+  profile->total_execution_time += execution_time;
+  if (execution_time < profile->min_execution_time)
+    {
+      profile->min_execution_time = execution_time;
+    }
+  if (execution_time > profile->max_execution_time)
+    {
+      profile->max_execution_time = execution_time;
+    }
+  profile->total_release_jitter += release_jitter;
+  if (release_jitter > profile->max_release_jitter)
+    {
+      profile->max_release_jitter = release_jitter;
+    }
+  if (completion >= taskPeriod(task))
+    {
+      profile->number_of_overruns++;
+    }
+}
+
+uint32_t
+readTimestamp(const PeriodicScheduler *self)
 {
-  task->ticks_elapsed = 0;
+  return (self->timestamp != NULL) ? self->timestamp() : 0;
 }
+#endif
 
-Task *
-getScheduledTaskById(const PeriodicScheduler *self,
-                     uint8_t index)
+void
+resetTask(InternalTask *task,
+          TickCount     now)
 {
-  InternalTask *task = self->tasks + index;
-  if (!task->is_valid)
+  task->next_due = now + taskPeriod(task);
+}
+
+Ticks
+taskPeriod(const InternalTask *task)
+{
+  // a period of 0 is handled as a single tick, so a pass always ends
+  return (task->task.period > 0) ? task->task.period : 1;
+}
+
+InternalTask *
+getValidTask(const PeriodicScheduler *self,
+             TaskId                   id)
+{
+  InternalTask *task = self->tasks + id;
+  if (id >= self->limit || !task->is_valid)
     {
       Throw(PERIODIC_SCHEDULER_INVALID_TASK_EXCEPTION);
     }
+  return task;
+}
+
+bool
+taskIsDue(const InternalTask *task,
+          TickCount           now)
+{
+  // wrap-safe, deadlines are never more than a period ahead
+  return (int32_t) (now - task->next_due) >= 0;
+}
+
+bool
+isDueEarlier(const PeriodicScheduler *self,
+             TaskId                   first,
+             TaskId                   second)
+{
+  return (int32_t) (self->tasks[first].next_due
+                    - self->tasks[second].next_due) < 0;
+}
+
+void
+placeInHeap(PeriodicScheduler *self,
+            TaskId             heap_index,
+            TaskId             task_index)
+{
+  self->heap[heap_index] = task_index;
+  self->tasks[task_index].heap_index = heap_index;
+}
+
+void
+insertIntoHeap(PeriodicScheduler *self,
+               TaskId             index)
+{
+  placeInHeap(self, self->number_of_tasks, index);
+  self->number_of_tasks++;
+  siftUp(self, self->number_of_tasks - 1);
+}
+
+void
+removeFromHeap(PeriodicScheduler *self,
+               TaskId             heap_index)
+{
+  self->number_of_tasks--;
+  if (heap_index < self->number_of_tasks)
+    {
+      TaskId moved_task = self->heap[self->number_of_tasks];
+      placeInHeap(self, heap_index, moved_task);
+      restoreHeapOrder(self, moved_task);
+    }
+}
+
+void
+restoreHeapOrder(PeriodicScheduler *self,
+                 TaskId             index)
+{
+  siftUp(self, self->tasks[index].heap_index);
+  siftDown(self, self->tasks[index].heap_index);
+}
+
+void
+siftUp(PeriodicScheduler *self,
+       TaskId             heap_index)
+{
+  TaskId index = self->heap[heap_index];
+  while (heap_index > 0)
+    {
+      TaskId parent = (heap_index - 1) / 2;
+      if (!isDueEarlier(self, index, self->heap[parent]))
+	{
+	  break;
+	}
+      placeInHeap(self, heap_index, self->heap[parent]);
+      heap_index = parent;
+    }
+  placeInHeap(self, heap_index, index);
+}
+
+void
+siftDown(PeriodicScheduler *self,
+         TaskId             heap_index)
+{
+  TaskId index = self->heap[heap_index];
+  for (;;)
+    {
+      size_t child = 2 * (size_t) heap_index + 1;
+      if (child >= self->number_of_tasks)
+	{
+	  break;
+	}
+      if (child + 1 < self->number_of_tasks
+	  && isDueEarlier(self, self->heap[child + 1], self->heap[child]))
+	{
+	  child++;
+	}
+      if (!isDueEarlier(self, self->heap[child], index))
+	{
+	  break;
+	}
+      placeInHeap(self, heap_index, self->heap[child]);
+      heap_index = (TaskId) child;
+    }
+  placeInHeap(self, heap_index, index);
+}
+
+TickCount
+readTickCounter(const PeriodicScheduler *self)
+{
+  // the counter may be wider than the cpu's word size, so read it
+  // again in case the timer interrupt has updated it in between
+  TickCount tick_counter;
+  do
+    {
+      tick_counter = self->tick_counter;
+    }
+  while (tick_counter != self->tick_counter);
+  return tick_counter;
+}
+
+Task *
+getScheduledTaskById(const PeriodicScheduler *self,
+                     TaskId index)
+{
+  InternalTask *task = getValidTask(self, index);
+  task->task.ticks_elapsed =
+    (Ticks) (readTickCounter(self) - (task->next_due - taskPeriod(task)));
   return (Task *) (self->tasks + index);
 }
 
 void
 removeScheduledTask(PeriodicScheduler *self,
-                    uint8_t id)
+                    TaskId id)
 {
   if (self->tasks[id].is_valid)
     {
       self->tasks[id].is_valid = false;
+      removeFromHeap(self, self->tasks[id].heap_index);
     }
   else
     {
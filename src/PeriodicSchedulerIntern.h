@@ -4,9 +4,61 @@
 #include "EmbeddedUtilities/PeriodicScheduler.h"
 
 static void
-executeTaskIfDue(InternalTask *tasks, uint8_t index);
+executeTask(PeriodicScheduler *self, TaskId index, TickCount now);
 
 static void
-resetTask(Task *task);
+resetTask(InternalTask *task, TickCount now);
+
+static Ticks
+taskPeriod(const InternalTask *task);
+
+static TickCount
+releaseOfDueInstance(const PeriodicScheduler *self, InternalTask *task,
+                     TickCount now, bool *execute);
+
+static InternalTask *
+getValidTask(const PeriodicScheduler *self, TaskId id);
+
+static bool
+taskIsDue(const InternalTask *task, TickCount now);
+
+static TickCount
+readTickCounter(const PeriodicScheduler *self);
+
+#if PERIODIC_SCHEDULER_PROFILING
+static void
+recordExecution(const PeriodicScheduler *self, InternalTask *task,
+                TickCount start_tick, uint32_t start_time);
+
+static uint32_t
+readTimestamp(const PeriodicScheduler *self);
+#endif
+
+/*
+ * The valid tasks are kept in a binary min-heap of task ids,
+ * ordered by their next deadline. Each task knows its position
+ * in the heap, so it can be removed without searching.
+ */
+
+static bool
+isDueEarlier(const PeriodicScheduler *self, TaskId first, TaskId second);
+
+static void
+placeInHeap(PeriodicScheduler *self, TaskId heap_index, TaskId task_index);
+
+static void
+insertIntoHeap(PeriodicScheduler *self, TaskId index);
+
+static void
+removeFromHeap(PeriodicScheduler *self, TaskId heap_index);
+
+static void
+restoreHeapOrder(PeriodicScheduler *self, TaskId index);
+
+static void
+siftUp(PeriodicScheduler *self, TaskId heap_index);
+
+static void
+siftDown(PeriodicScheduler *self, TaskId heap_index);
 
 #endif //PERIODICSCHEDULER_PERIODICSCHEDULERINTERN_H
@@ -0,0 +1,213 @@
+#include "EmbeddedUtilities/Pipeline.h"
+#include <string.h>
+
+/**
+ *  Helper function
+ */
+static void
+invokeCallback(const GenericCallback *callback);
+
+/**
+ *  Helper function
+ */
+static size_t
+claimBatch(PipelineStage *stage, const void **items);
+
+/**
+ *  Helper function
+ */
+static uint32_t
+readTimestamp(const Pipeline *pipeline);
+
+void
+initPipeline(Pipeline *self)
+{
+  memset(self, 0, sizeof(Pipeline));
+}
+
+void
+setPipelineTimestampSource(Pipeline *self, uint32_t (*timestamp)(void))
+{
+  self->timestamp = timestamp;
+}
+
+void
+addStageToPipeline(Pipeline *self, PipelineStage *stage, const PipelineStageConfig *config)
+{
+  memset(stage, 0, sizeof(PipelineStage));
+  stage->config = *config;
+  stage->reader_descriptor = getNewBufferReaderDescriptor(config->input);  // Can throw exceptions
+  stage->pipeline = self;
+
+  if (self->last_stage == NULL)
+  {
+    self->first_stage = stage;
+  }
+  else
+  {
+    self->last_stage->next = stage;
+  }
+  self->last_stage = stage;
+}
+
+BufferStatus
+pushToPipeline(Pipeline *self, Buffer *buffer, const void *items, size_t count)
+{
+  BufferStatus status = BUFFER_FULL;
+
+  invokeCallback(&self->lock);
+  if (getFreeSpaceOfBuffer(buffer) >= count)
+  {
+    pushManyToBuffer(buffer, items, count);
+    status = BUFFER_OK;
+  }
+  invokeCallback(&self->unlock);
+
+  if (status == BUFFER_OK)
+  {
+    invokeCallback(&self->work_available);
+  }
+  return status;
+}
+
+BufferStatus
+emitFromPipelineStage(PipelineStage *stage, const void *items, size_t count)
+{
+  Pipeline *pipeline = stage->pipeline;
+  BufferStatus status = BUFFER_FULL;
+
+  invokeCallback(&pipeline->lock);
+  if (stage->config.output != NULL && getFreeSpaceOfBuffer(stage->config.output) >= count)
+  {
+    pushManyToBuffer(stage->config.output, items, count);
+    stage->metrics.emitted_items += count;
+    status = BUFFER_OK;
+  }
+  else
+  {
+    stage->metrics.dropped_items += count;
+  }
+  invokeCallback(&pipeline->unlock);
+
+  if (status == BUFFER_OK)
+  {
+    invokeCallback(&pipeline->work_available);
+  }
+  return status;
+}
+
+size_t
+runPipelineStage(Pipeline *self, PipelineStage *stage)
+{
+  const void *items;
+
+  invokeCallback(&self->lock);
+  size_t count = claimBatch(stage, &items);
+  invokeCallback(&self->unlock);
+
+  if (count == 0)
+  {
+    return 0;
+  }
+
+  /*
+   * The items are processed in place without holding the lock. The producer of the input buffer
+   * cannot overwrite them, since the reader is advanced only afterwards and all pushes respect the free space.
+   */
+
+  uint32_t start = readTimestamp(self);
+  stage->config.function(stage, stage->config.context, items, count);
+  uint32_t batch_time = readTimestamp(self) - start;
+
+  invokeCallback(&self->lock);
+  consumeWithReader(stage->config.input, stage->reader_descriptor, count);
+  stage->metrics.consumed_items += count;
+  stage->metrics.batches++;
+  stage->metrics.busy_time += batch_time;
+  if (batch_time > stage->metrics.max_batch_time)
+  {
+    stage->metrics.max_batch_time = batch_time;
+  }
+  stage->running = false;
+  invokeCallback(&self->unlock);
+
+  invokeCallback(&self->work_available);  // The upstream stage may wait for the free space
+  return count;
+}
+
+size_t
+runPipelineOnce(Pipeline *self)
+{
+  size_t processed_items = 0;
+
+  for (PipelineStage *stage = self->first_stage; stage != NULL; stage = stage->next)
+  {
+    processed_items += runPipelineStage(self, stage);
+  }
+  return processed_items;
+}
+
+void
+getPipelineStageMetrics(Pipeline *self, const PipelineStage *stage, PipelineStageMetrics *metrics)
+{
+  invokeCallback(&self->lock);
+  *metrics = stage->metrics;
+  invokeCallback(&self->unlock);
+}
+
+/* Helper functions */
+
+size_t
+claimBatch(PipelineStage *stage, const void **items)
+{
+  /* Called with the lock held, marks the stage as running if it gets a batch */
+
+  if (stage->running)
+  {
+    return 0;
+  }
+
+  BufferSpan span;
+  peekSpanWithReader(stage->config.input, stage->reader_descriptor, &span);
+
+  *items = span.first;
+
+  size_t count = span.first_length;  // A wrapped-around remainder is handed over with the next batch
+
+  if (stage->config.batch_size > 0 && count > stage->config.batch_size)
+  {
+    count = stage->config.batch_size;
+  }
+
+  if (count > 0 && stage->config.output != NULL && stage->config.max_outputs_per_input > 0)
+  {
+    size_t processable_items = getFreeSpaceOfBuffer(stage->config.output) / stage->config.max_outputs_per_input;
+
+    if (processable_items < count)
+    {
+      count = processable_items;
+      if (count == 0)
+      {
+        stage->metrics.stalls++;
+      }
+    }
+  }
+
+  stage->running = (count > 0);
+  return count;
+}
+
+uint32_t
+readTimestamp(const Pipeline *pipeline)
+{
+  return (pipeline->timestamp != NULL) ? pipeline->timestamp() : 0;
+}
+
+void
+invokeCallback(const GenericCallback *callback)
+{
+  if (callback->function != NULL)
+  {
+    callback->function(callback->argument);
+  }
+}
@@ -0,0 +1,140 @@
+#include "EmbeddedUtilities/PipelineWorkers.h"
+
+/**
+ *  Helper function
+ */
+static void*
+runWorker(void *argument);
+
+/**
+ *  Helper function
+ */
+static void
+lockPipeline(void *argument);
+
+/**
+ *  Helper function
+ */
+static void
+unlockPipeline(void *argument);
+
+/**
+ *  Helper function
+ */
+static void
+signalWorkAvailable(void *argument);
+
+/**
+ *  Helper function
+ */
+static void
+joinWorkers(PipelineWorkers *workers);
+
+BufferStatus
+startPipelineWorkers(PipelineWorkers *self, Pipeline *pipeline, size_t number_of_workers)
+{
+  if (number_of_workers == 0 || number_of_workers > PIPELINE_MAX_WORKERS)
+  {
+    return BUFFER_INVALID_CAPACITY;
+  }
+
+  self->pipeline = pipeline;
+  self->number_of_workers = 0;
+  self->work_counter = 0;
+  self->running = true;
+  pthread_mutex_init(&self->mutex, NULL);
+  pthread_cond_init(&self->work_available, NULL);
+
+  pipeline->lock = (GenericCallback) {lockPipeline, self};
+  pipeline->unlock = (GenericCallback) {unlockPipeline, self};
+  pipeline->work_available = (GenericCallback) {signalWorkAvailable, self};
+
+  while (self->number_of_workers < number_of_workers)
+  {
+    if (pthread_create(self->threads + self->number_of_workers, NULL, runWorker, self) != 0)
+    {
+      stopPipelineWorkers(self);
+      return BUFFER_UNAVAILABLE;
+    }
+    self->number_of_workers++;
+  }
+  return BUFFER_OK;
+}
+
+void
+stopPipelineWorkers(PipelineWorkers *self)
+{
+  pthread_mutex_lock(&self->mutex);
+  self->running = false;
+  pthread_cond_broadcast(&self->work_available);
+  pthread_mutex_unlock(&self->mutex);
+
+  joinWorkers(self);
+
+  self->pipeline->lock = (GenericCallback) {NULL, NULL};
+  self->pipeline->unlock = (GenericCallback) {NULL, NULL};
+  self->pipeline->work_available = (GenericCallback) {NULL, NULL};
+  pthread_cond_destroy(&self->work_available);
+  pthread_mutex_destroy(&self->mutex);
+}
+
+/* Helper functions */
+
+void*
+runWorker(void *argument)
+{
+  PipelineWorkers *workers = argument;
+
+  pthread_mutex_lock(&workers->mutex);
+  while (workers->running)
+  {
+    uint64_t seen_work_counter = workers->work_counter;
+
+    pthread_mutex_unlock(&workers->mutex);
+    size_t processed_items = runPipelineOnce(workers->pipeline);
+    pthread_mutex_lock(&workers->mutex);
+
+    /* Work that has been added while the stages were visited is noticed by the changed counter */
+
+    while (processed_items == 0 && workers->running && workers->work_counter == seen_work_counter)
+    {
+      pthread_cond_wait(&workers->work_available, &workers->mutex);
+    }
+  }
+  pthread_mutex_unlock(&workers->mutex);
+
+  return NULL;
+}
+
+void
+joinWorkers(PipelineWorkers *workers)
+{
+  for (size_t index = 0; index < workers->number_of_workers; ++index)
+  {
+    pthread_join(workers->threads[index], NULL);
+  }
+  workers->number_of_workers = 0;
+}
+
+void
+lockPipeline(void *argument)
+{
+  pthread_mutex_lock(&((PipelineWorkers*) argument)->mutex);
+}
+
+void
+unlockPipeline(void *argument)
+{
+  pthread_mutex_unlock(&((PipelineWorkers*) argument)->mutex);
+}
+
+void
+signalWorkAvailable(void *argument)
+{
+  PipelineWorkers *workers = argument;
+
+  pthread_mutex_lock(&workers->mutex);
+  workers->work_counter++;
+  pthread_cond_broadcast(&workers->work_available);
+  pthread_mutex_unlock(&workers->mutex);
+}
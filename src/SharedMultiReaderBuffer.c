@@ -0,0 +1,127 @@
+#include "EmbeddedUtilities/SharedMultiReaderBuffer.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SHARED_MULTI_READER_BUFFER_MAGIC (0x4D524246)  // "MRBF"
+
+/*
+ * The header precedes the buffer in the shared memory object. It fills a whole
+ * cache line, so the buffer behind it keeps the alignment it requires.
+ */
+
+typedef struct SharedBufferHeader
+{
+  _Alignas(CONCURRENT_MULTI_READER_BUFFER_CACHE_LINE_SIZE) uint32_t magic;
+  _Atomic uint32_t initialized;
+} SharedBufferHeader;
+
+/**
+ *  Helper function
+ */
+static BufferStatus
+mapSharedMemory(SharedMultiReaderBuffer *self, int file_descriptor, size_t size);
+
+BufferStatus
+createSharedMultiReaderBuffer(SharedMultiReaderBuffer *self, const char *name, size_t word_size, size_t max_elements, size_t max_readers, MultiReaderBufferOptions options)
+{
+  size_t size = sizeof(SharedBufferHeader) + CONCURRENT_MULTI_READER_BUFFER_SIZE(word_size, max_elements, max_readers);
+  int file_descriptor = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+
+  if (file_descriptor < 0)
+  {
+    return BUFFER_UNAVAILABLE;
+  }
+
+  if (ftruncate(file_descriptor, size) != 0 || mapSharedMemory(self, file_descriptor, size) != BUFFER_OK)
+  {
+    close(file_descriptor);
+    shm_unlink(name);
+    return BUFFER_UNAVAILABLE;
+  }
+
+  close(file_descriptor);
+
+  /* A new shared memory object is zeroed, so it is not yet flagged as initialized */
+
+  SharedBufferHeader *header = (SharedBufferHeader*) self->mapping;
+  BufferStatus status = initConcurrentMultiReaderBufferWithOptions(self->buffer, word_size, max_elements, max_readers, options);
+
+  if (status != BUFFER_OK)
+  {
+    detachSharedMultiReaderBuffer(self);
+    shm_unlink(name);
+    return status;
+  }
+
+  header->magic = SHARED_MULTI_READER_BUFFER_MAGIC;
+  atomic_store_explicit(&header->initialized, 1, memory_order_release);
+
+  return BUFFER_OK;
+}
+
+BufferStatus
+attachSharedMultiReaderBuffer(SharedMultiReaderBuffer *self, const char *name)
+{
+  int file_descriptor = shm_open(name, O_RDWR, 0);
+  struct stat file_status;
+
+  if (file_descriptor < 0)
+  {
+    return BUFFER_UNAVAILABLE;
+  }
+
+  if (fstat(file_descriptor, &file_status) != 0 || (size_t) file_status.st_size < sizeof(SharedBufferHeader)
+      || mapSharedMemory(self, file_descriptor, file_status.st_size) != BUFFER_OK)
+  {
+    close(file_descriptor);
+    return BUFFER_UNAVAILABLE;
+  }
+
+  close(file_descriptor);
+
+  SharedBufferHeader *header = (SharedBufferHeader*) self->mapping;
+
+  if (!atomic_load_explicit(&header->initialized, memory_order_acquire) || header->magic != SHARED_MULTI_READER_BUFFER_MAGIC)
+  {
+    detachSharedMultiReaderBuffer(self);
+    return BUFFER_UNAVAILABLE;
+  }
+
+  return BUFFER_OK;
+}
+
+void
+detachSharedMultiReaderBuffer(SharedMultiReaderBuffer *self)
+{
+  munmap(self->mapping, self->mapping_size);
+  self->mapping = NULL;
+  self->buffer = NULL;
+  self->mapping_size = 0;
+}
+
+void
+removeSharedMultiReaderBuffer(const char *name)
+{
+  shm_unlink(name);
+}
+
+/* Helper functions */
+
+BufferStatus
+mapSharedMemory(SharedMultiReaderBuffer *self, int file_descriptor, size_t size)
+{
+  void *mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+
+  if (mapping == MAP_FAILED)
+  {
+    return BUFFER_UNAVAILABLE;
+  }
+
+  self->mapping = mapping;
+  self->mapping_size = size;
+  self->buffer = (ConcurrentMultiReaderBuffer*) (((uint8_t*) mapping) + sizeof(SharedBufferHeader));
+
+  return BUFFER_OK;
+}
@@ -0,0 +1,313 @@
+#include "EmbeddedUtilities/WindowStatistics.h"
+#include <string.h>
+
+/**
+ *  Helper function
+ */
+static size_t*
+minimumDequeSlots(const WindowStatistics *window);
+
+/**
+ *  Helper function
+ */
+static size_t*
+maximumDequeSlots(const WindowStatistics *window);
+
+/**
+ *  Helper function
+ */
+static uint8_t*
+sampleSlot(const WindowStatistics *window, size_t index);
+
+/**
+ *  Helper function
+ */
+static size_t
+ringIndex(const WindowStatistics *window, size_t index);
+
+/**
+ *  Helper function
+ */
+static int
+compareSamples(WindowSampleType sample_type, const void *first, const void *second);
+
+/**
+ *  Helper function
+ */
+static void
+addChunk(WindowStatistics *window, const uint8_t *samples, size_t count);
+
+/**
+ *  Helper function
+ */
+static void
+updateSums(WindowStatistics *window, const void *samples, size_t count, bool subtract);
+
+/**
+ *  Helper function
+ */
+static void
+dropEvictedSlots(WindowStatistics *window, WindowDeque *deque, size_t *slots, size_t first_slot, size_t count);
+
+/**
+ *  Helper function
+ */
+static void
+pushToDeque(WindowStatistics *window, WindowDeque *deque, size_t *slots, size_t slot, int order);
+
+void
+initWindowStatistics(WindowStatistics *self, WindowSampleType sample_type, size_t window_length)
+{
+  self->sample_type = sample_type;
+  self->sample_size = (sample_type == WINDOW_SAMPLES_INT16) ? sizeof(int16_t) : (sample_type == WINDOW_SAMPLES_INT32) ? sizeof(int32_t) : sizeof(float);
+  self->window_length = window_length;
+
+  resetWindowStatistics(self);
+}
+
+void
+resetWindowStatistics(WindowStatistics *self)
+{
+  self->number_of_samples = 0;
+  self->write_index = 0;
+  self->integer_sum = 0;
+  self->integer_sum_of_squares = 0;
+  self->float_sum = 0;
+  self->float_sum_of_squares = 0;
+  self->minimum.head = 0;
+  self->minimum.length = 0;
+  self->maximum.head = 0;
+  self->maximum.length = 0;
+}
+
+void
+addSampleToWindow(WindowStatistics *self, const void *sample)
+{
+  addChunk(self, (const uint8_t*) sample, 1);
+}
+
+void
+addSamplesToWindow(WindowStatistics *self, const void *samples, size_t count)
+{
+  const uint8_t *source = (const uint8_t*) samples;
+
+  if (count > self->window_length)
+  {
+    /* The older samples would be evicted by the newer ones anyway */
+
+    resetWindowStatistics(self);
+    source += (count - self->window_length) * self->sample_size;
+    count = self->window_length;
+  }
+
+  while (count > 0)
+  {
+    size_t slots_until_wrap = self->window_length - self->write_index;
+    size_t chunk = (count < slots_until_wrap) ? count : slots_until_wrap;
+
+    addChunk(self, source, chunk);
+    source += chunk * self->sample_size;
+    count -= chunk;
+  }
+}
+
+size_t
+addSamplesFromBufferReader(WindowStatistics *self, Buffer *buffer, uint8_t reader_descriptor)
+{
+  BufferSpan span;
+  size_t count = peekSpanWithReader(buffer, reader_descriptor, &span);  // Can throw exceptions
+
+  addSamplesToWindow(self, span.first, span.first_length);
+  addSamplesToWindow(self, span.second, span.second_length);
+  consumeWithReader(buffer, reader_descriptor, count);
+
+  return count;
+}
+
+void
+getWindowStatistics(const WindowStatistics *self, WindowStatisticsSummary *summary)
+{
+  memset(summary, 0, sizeof(WindowStatisticsSummary));
+  summary->number_of_samples = self->number_of_samples;
+
+  if (self->number_of_samples == 0)
+  {
+    return;
+  }
+
+  memcpy(&summary->minimum, sampleSlot(self, minimumDequeSlots(self)[self->minimum.head]), self->sample_size);
+  memcpy(&summary->maximum, sampleSlot(self, maximumDequeSlots(self)[self->maximum.head]), self->sample_size);
+
+  double number_of_samples = (double) self->number_of_samples;
+  double sum = (self->sample_type == WINDOW_SAMPLES_FLOAT) ? self->float_sum : (double) self->integer_sum;
+  double sum_of_squares = (self->sample_type == WINDOW_SAMPLES_FLOAT) ? self->float_sum_of_squares : (double) self->integer_sum_of_squares;
+
+  summary->mean = sum / number_of_samples;
+  summary->variance = (sum_of_squares - sum * summary->mean) / number_of_samples;
+
+  if (summary->variance < 0)
+  {
+    summary->variance = 0;  // Rounding error for (almost) constant samples
+  }
+}
+
+/* Helper functions */
+
+void
+addChunk(WindowStatistics *window, const uint8_t *samples, size_t count)
+{
+  /* The chunk does not wrap around, so its slots can be handled as arrays */
+
+  size_t first_slot = window->write_index;
+
+  if (window->number_of_samples == window->window_length)
+  {
+    updateSums(window, sampleSlot(window, first_slot), count, true);
+    dropEvictedSlots(window, &window->minimum, minimumDequeSlots(window), first_slot, count);
+    dropEvictedSlots(window, &window->maximum, maximumDequeSlots(window), first_slot, count);
+  }
+  else
+  {
+    window->number_of_samples += count;  // Before the first wrap-around the slots behind the write index are free
+  }
+
+  memcpy(sampleSlot(window, first_slot), samples, count * window->sample_size);
+  updateSums(window, samples, count, false);
+
+  for (size_t slot = first_slot; slot < first_slot + count; ++slot)
+  {
+    pushToDeque(window, &window->minimum, minimumDequeSlots(window), slot, 1);
+    pushToDeque(window, &window->maximum, maximumDequeSlots(window), slot, -1);
+  }
+
+  window->write_index = ringIndex(window, first_slot + count);
+
+  if (window->write_index == 0 && window->sample_type == WINDOW_SAMPLES_FLOAT)
+  {
+    /* Once per window, so rounding errors of adding and subtracting do not pile up */
+
+    window->float_sum = 0;
+    window->float_sum_of_squares = 0;
+    updateSums(window, sampleSlot(window, 0), window->number_of_samples, false);
+  }
+}
+
+void
+updateSums(WindowStatistics *window, const void *samples, size_t count, bool subtract)
+{
+  /* Sum up the batch first in a plain loop per type, which the compiler can vectorize */
+
+  if (window->sample_type == WINDOW_SAMPLES_FLOAT)
+  {
+    const float *values = (const float*) samples;
+    double sum = 0;
+    double sum_of_squares = 0;
+
+    for (size_t index = 0; index < count; ++index)
+    {
+      sum += values[index];
+      sum_of_squares += (double) values[index] * values[index];
+    }
+
+    window->float_sum += subtract ? -sum : sum;
+    window->float_sum_of_squares += subtract ? -sum_of_squares : sum_of_squares;
+    return;
+  }
+
+  int64_t sum = 0;
+  uint64_t sum_of_squares = 0;
+
+  if (window->sample_type == WINDOW_SAMPLES_INT16)
+  {
+    const int16_t *values = (const int16_t*) samples;
+
+    for (size_t index = 0; index < count; ++index)
+    {
+      sum += values[index];
+      sum_of_squares += (uint32_t) ((int32_t) values[index] * values[index]);
+    }
+  }
+  else
+  {
+    const int32_t *values = (const int32_t*) samples;
+
+    for (size_t index = 0; index < count; ++index)
+    {
+      sum += values[index];
+      sum_of_squares += (uint64_t) ((int64_t) values[index] * values[index]);
+    }
+  }
+
+  window->integer_sum += subtract ? -sum : sum;
+  window->integer_sum_of_squares += subtract ? -sum_of_squares : sum_of_squares;  // Exact modulo 2^64
+}
+
+void
+dropEvictedSlots(WindowStatistics *window, WindowDeque *deque, size_t *slots, size_t first_slot, size_t count)
+{
+  /* The evicted samples are the oldest ones, so if they are in the deque, they are at its front */
+
+  while (deque->length > 0 && slots[deque->head] >= first_slot && slots[deque->head] < first_slot + count)
+  {
+    deque->head = ringIndex(window, deque->head + 1);
+    deque->length--;
+  }
+}
+
+void
+pushToDeque(WindowStatistics *window, WindowDeque *deque, size_t *slots, size_t slot, int order)
+{
+  /*
+   * Older samples that are not smaller (order 1) or not larger (order -1) than the new one
+   * can never become the minimum (maximum) again, since they leave the window first
+   */
+
+  while (deque->length > 0
+         && order * compareSamples(window->sample_type, sampleSlot(window, slots[ringIndex(window, deque->head + deque->length - 1)]), sampleSlot(window, slot)) >= 0)
+  {
+    deque->length--;
+  }
+
+  slots[ringIndex(window, deque->head + deque->length)] = slot;
+  deque->length++;
+}
+
+int
+compareSamples(WindowSampleType sample_type, const void *first, const void *second)
+{
+  if (sample_type == WINDOW_SAMPLES_INT16)
+  {
+    return (*(const int16_t*) first > *(const int16_t*) second) - (*(const int16_t*) first < *(const int16_t*) second);
+  }
+
+  if (sample_type == WINDOW_SAMPLES_INT32)
+  {
+    return (*(const int32_t*) first > *(const int32_t*) second) - (*(const int32_t*) first < *(const int32_t*) second);
+  }
+
+  return (*(const float*) first > *(const float*) second) - (*(const float*) first < *(const float*) second);
+}
+
+size_t
+ringIndex(const WindowStatistics *window, size_t index)
+{
+  return (index >= window->window_length) ? index - window->window_length : index;  // Indexes never exceed two laps
+}
+
+size_t*
+minimumDequeSlots(const WindowStatistics *window)
+{
+  return (size_t*) (window + 1);
+}
+
+size_t*
+maximumDequeSlots(const WindowStatistics *window)
+{
+  return minimumDequeSlots(window) + window->window_length;
+}
+
+uint8_t*
+sampleSlot(const WindowStatistics *window, size_t index)
+{
+  return (uint8_t*) (maximumDequeSlots(window) + window->window_length) + index * window->sample_size;
+}
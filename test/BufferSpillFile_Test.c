@@ -0,0 +1,117 @@
+#include <unity.h>
+#include <CException.h>
+#include "EmbeddedUtilities/BufferSpillFile.h"
+
+#define MAX_ELEMENTS (16)
+#define MAX_READERS (2)
+#define SEGMENT_SIZE (8)
+#define SPILL_FILE_PATH "/tmp/BufferSpillFile_Test.spill"
+
+static uint8_t raw_memory[MULTI_READER_BUFFER_SIZE(sizeof(uint32_t), MAX_ELEMENTS, MAX_READERS)];
+static Buffer *buffer = (Buffer*) &raw_memory;
+static BufferSpillFile spill_file;
+static uint8_t durable_reader;
+
+static void
+pushValues(uint32_t first, uint32_t count)
+{
+  for (uint32_t value = first; value < first + count; value++)
+  {
+    pushToBuffer(buffer, &value);
+  }
+}
+
+static void
+popValuesInOrder(uint32_t first, uint32_t count)
+{
+  uint32_t value;
+
+  for (uint32_t expected = first; expected < first + count; expected++)
+  {
+    TEST_ASSERT_EQUAL(BUFFER_OK, popFromBufferWithSpillFile(&spill_file, &value));
+    TEST_ASSERT_EQUAL_UINT32(expected, value);
+  }
+}
+
+void
+setUp(void)
+{
+  initMultiReaderBuffer((MultiReaderBuffer*) buffer, sizeof(uint32_t), MAX_ELEMENTS, MAX_READERS);
+  durable_reader = getNewBufferReaderDescriptor(buffer);
+  TEST_ASSERT_EQUAL(BUFFER_OK, openBufferSpillFile(&spill_file, buffer, durable_reader, SPILL_FILE_PATH, SEGMENT_SIZE));
+}
+
+void
+tearDown(void)
+{
+  closeBufferSpillFile(&spill_file);
+}
+
+void
+test_durableReaderLosesNoItemsOfBurst(void)
+{
+  uint32_t value;
+
+  pushValues(0, 10 * MAX_ELEMENTS);
+
+  TEST_ASSERT_TRUE(getNumberOfSpilledElements(&spill_file) >= 9 * MAX_ELEMENTS);
+  TEST_ASSERT_TRUE(spill_file.mapping_size > SEGMENT_SIZE * sizeof(uint32_t));
+  popValuesInOrder(0, 10 * MAX_ELEMENTS);
+  TEST_ASSERT_EQUAL(BUFFER_EMPTY, popFromBufferWithSpillFile(&spill_file, &value));
+  TEST_ASSERT_EQUAL(0, getNumberOfSpilledElements(&spill_file));
+  TEST_ASSERT_EQUAL(SEGMENT_SIZE * sizeof(uint32_t), spill_file.mapping_size);
+}
+
+void
+test_readingKeepsUpWithoutSpilling(void)
+{
+  for (uint32_t round = 0; round < 10; round++)
+  {
+    pushValues(round * MAX_ELEMENTS, MAX_ELEMENTS);
+    popValuesInOrder(round * MAX_ELEMENTS, MAX_ELEMENTS);
+  }
+
+  TEST_ASSERT_EQUAL(0, getNumberOfSpilledElements(&spill_file));
+}
+
+void
+test_spillingAlternatesWithReading(void)
+{
+  pushValues(0, 3 * MAX_ELEMENTS);
+  popValuesInOrder(0, MAX_ELEMENTS);
+  pushValues(3 * MAX_ELEMENTS, 2 * MAX_ELEMENTS);
+  popValuesInOrder(MAX_ELEMENTS, 4 * MAX_ELEMENTS);
+}
+
+void
+test_otherReadersAreStillOverrun(void)
+{
+  uint8_t other_reader = getNewBufferReaderDescriptor(buffer);
+  const void *item;
+
+  pushValues(0, 2 * MAX_ELEMENTS);
+
+  TEST_ASSERT_EQUAL(BUFFER_OVERRUN, tryPopFromBufferWithReader(buffer, other_reader, &item));
+  popValuesInOrder(0, 2 * MAX_ELEMENTS);
+}
+
+void
+test_closingRemovesTheSpillHandler(void)
+{
+  const void *item;
+
+  closeBufferSpillFile(&spill_file);
+  pushValues(0, 2 * MAX_ELEMENTS);
+
+  TEST_ASSERT_EQUAL(BUFFER_OVERRUN, tryPopFromBufferWithReader(buffer, durable_reader, &item));
+  TEST_ASSERT_EQUAL(BUFFER_OK, openBufferSpillFile(&spill_file, buffer, durable_reader, SPILL_FILE_PATH, SEGMENT_SIZE));
+}
+
+void
+test_openFailsForInvalidPath(void)
+{
+  BufferSpillFile other_spill_file;
+
+  TEST_ASSERT_EQUAL(BUFFER_UNAVAILABLE, openBufferSpillFile(&other_spill_file, buffer, durable_reader, "/nonexistent/directory/file", SEGMENT_SIZE));
+  TEST_ASSERT_EQUAL(MAX_READERS, ((MultiReaderBuffer*) buffer)->durable_reader);
+}
@@ -0,0 +1,611 @@
+#include <unity.h>
+#include <pthread.h>
+#include <time.h>
+#include "EmbeddedUtilities/ConcurrentMultiReaderBuffer.h"
+
+#define MAX_ELEMENTS (64)
+#define MAX_READERS (4)
+
+typedef struct CheckedItem
+{
+  uint64_t value;
+  uint64_t inverted_value;
+} CheckedItem;
+
+static _Alignas(CONCURRENT_MULTI_READER_BUFFER_CACHE_LINE_SIZE) uint8_t raw_memory[CONCURRENT_MULTI_READER_BUFFER_SIZE(sizeof(CheckedItem), MAX_ELEMENTS, MAX_READERS)];
+static ConcurrentMultiReaderBuffer *buffer = (ConcurrentMultiReaderBuffer*) raw_memory;
+
+void
+setUp(void)
+{
+  initConcurrentMultiReaderBuffer(buffer, sizeof(CheckedItem), MAX_ELEMENTS, MAX_READERS);
+}
+
+static void
+pushValue(uint64_t value)
+{
+  CheckedItem item = {.value = value, .inverted_value = ~value};
+  pushToConcurrentBuffer(buffer, &item);
+}
+
+void
+test_initWithCapacityThatIsNoPowerOfTwoFails(void)
+{
+  TEST_ASSERT_EQUAL(BUFFER_INVALID_CAPACITY, initConcurrentMultiReaderBuffer(buffer, sizeof(CheckedItem), 48, MAX_READERS));
+}
+
+void
+test_getReaderDescriptorsUntilSlotsAreExhausted(void)
+{
+  uint8_t descriptor = 0;
+  for (uint8_t descriptor_number = 0; descriptor_number < MAX_READERS; ++descriptor_number)
+  {
+    TEST_ASSERT_EQUAL(BUFFER_OK, getNewConcurrentBufferReaderDescriptor(buffer, &descriptor));
+    TEST_ASSERT_EQUAL(descriptor_number, descriptor);
+  }
+  TEST_ASSERT_EQUAL(BUFFER_NO_FREE_READER_SLOTS, getNewConcurrentBufferReaderDescriptor(buffer, &descriptor));
+
+  TEST_ASSERT_EQUAL(BUFFER_OK, deleteConcurrentBufferReaderDescriptor(buffer, 2));
+  TEST_ASSERT_EQUAL(BUFFER_OK, getNewConcurrentBufferReaderDescriptor(buffer, &descriptor));
+  TEST_ASSERT_EQUAL(2, descriptor);
+}
+
+void
+test_popWithInvalidReader(void)
+{
+  CheckedItem item;
+  TEST_ASSERT_EQUAL(BUFFER_INVALID_READER, popFromConcurrentBufferWithReader(buffer, 0, &item));
+  TEST_ASSERT_EQUAL(BUFFER_INVALID_READER, popFromConcurrentBufferWithReader(buffer, MAX_READERS, &item));
+  TEST_ASSERT_EQUAL(BUFFER_INVALID_READER, deleteConcurrentBufferReaderDescriptor(buffer, MAX_READERS));
+}
+
+void
+test_pushPopWithTwoReaders(void)
+{
+  uint8_t reader1, reader2;
+  getNewConcurrentBufferReaderDescriptor(buffer, &reader1);
+  getNewConcurrentBufferReaderDescriptor(buffer, &reader2);
+
+  TEST_ASSERT_FALSE(readableItemExistsForConcurrentReader(buffer, reader1));
+  pushValue(5);
+  pushValue(6);
+  TEST_ASSERT_TRUE(readableItemExistsForConcurrentReader(buffer, reader1));
+
+  CheckedItem item;
+  TEST_ASSERT_EQUAL(BUFFER_OK, popFromConcurrentBufferWithReader(buffer, reader1, &item));
+  TEST_ASSERT_EQUAL_UINT64(5, item.value);
+  TEST_ASSERT_EQUAL(BUFFER_OK, popFromConcurrentBufferWithReader(buffer, reader1, &item));
+  TEST_ASSERT_EQUAL_UINT64(6, item.value);
+  TEST_ASSERT_EQUAL(BUFFER_EMPTY, popFromConcurrentBufferWithReader(buffer, reader1, &item));
+
+  TEST_ASSERT_EQUAL(BUFFER_OK, popFromConcurrentBufferWithReader(buffer, reader2, &item));
+  TEST_ASSERT_EQUAL_UINT64(5, item.value);
+}
+
+void
+test_fullBufferCanBeReadWithoutOverrun(void)
+{
+  uint8_t reader;
+  getNewConcurrentBufferReaderDescriptor(buffer, &reader);
+
+  for (uint64_t value = 0; value < MAX_ELEMENTS; value++)
+  {
+    pushValue(value);
+  }
+
+  CheckedItem item;
+  for (uint64_t value = 0; value < MAX_ELEMENTS; value++)
+  {
+    TEST_ASSERT_EQUAL(BUFFER_OK, popFromConcurrentBufferWithReader(buffer, reader, &item));
+    TEST_ASSERT_EQUAL_UINT64(value, item.value);
+  }
+}
+
+void
+test_overrunReaderContinuesWithOldestItem(void)
+{
+  uint8_t reader;
+  getNewConcurrentBufferReaderDescriptor(buffer, &reader);
+
+  for (uint64_t value = 0; value < MAX_ELEMENTS + 3; value++)
+  {
+    pushValue(value);
+  }
+
+  CheckedItem item;
+  TEST_ASSERT_EQUAL(BUFFER_OVERRUN, popFromConcurrentBufferWithReader(buffer, reader, &item));
+  TEST_ASSERT_EQUAL(BUFFER_OK, popFromConcurrentBufferWithReader(buffer, reader, &item));
+  TEST_ASSERT_EQUAL_UINT64(3, item.value);
+}
+
+void
+test_newReaderStartsAtOldestItem(void)
+{
+  for (uint64_t value = 0; value < 2 * MAX_ELEMENTS; value++)
+  {
+    pushValue(value);
+  }
+
+  uint8_t reader;
+  getNewConcurrentBufferReaderDescriptor(buffer, &reader);
+
+  CheckedItem item;
+  TEST_ASSERT_EQUAL(BUFFER_OK, popFromConcurrentBufferWithReader(buffer, reader, &item));
+  TEST_ASSERT_EQUAL_UINT64(MAX_ELEMENTS, item.value);
+}
+
+void
+test_rejectingBufferReturnsFullForSlowestReader(void)
+{
+  initConcurrentMultiReaderBufferWithOptions(buffer, sizeof(CheckedItem), MAX_ELEMENTS, MAX_READERS, MULTI_READER_BUFFER_REJECT_WHEN_FULL);
+  uint8_t reader;
+  getNewConcurrentBufferReaderDescriptor(buffer, &reader);
+
+  CheckedItem item = {0};
+  for (uint64_t value = 0; value < MAX_ELEMENTS; value++)
+  {
+    TEST_ASSERT_EQUAL(BUFFER_OK, pushToConcurrentBuffer(buffer, &item));
+  }
+  TEST_ASSERT_EQUAL(0, getFreeSpaceOfConcurrentBuffer(buffer));
+  TEST_ASSERT_EQUAL(BUFFER_FULL, pushToConcurrentBuffer(buffer, &item));
+
+  popFromConcurrentBufferWithReader(buffer, reader, &item);
+  TEST_ASSERT_EQUAL(1, getFreeSpaceOfConcurrentBuffer(buffer));
+  TEST_ASSERT_EQUAL(BUFFER_OK, pushToConcurrentBuffer(buffer, &item));
+}
+
+#define BLOCKING_TEST_ITEMS (20 * MAX_ELEMENTS)
+
+static void*
+produceBlockingItems(void *argument)
+{
+  for (uint64_t value = 0; value < BLOCKING_TEST_ITEMS; value++)
+  {
+    pushValue(value);
+  }
+
+  return NULL;
+}
+
+void
+test_blockingBufferMakesProducerWaitForReader(void)
+{
+  initConcurrentMultiReaderBufferWithOptions(buffer, sizeof(CheckedItem), MAX_ELEMENTS, MAX_READERS, MULTI_READER_BUFFER_BLOCK_WHEN_FULL);
+  uint8_t reader;
+  getNewConcurrentBufferReaderDescriptor(buffer, &reader);
+
+  pthread_t producer;
+  pthread_create(&producer, NULL, produceBlockingItems, NULL);
+
+  CheckedItem item;
+  for (uint64_t value = 0; value < BLOCKING_TEST_ITEMS;)
+  {
+    BufferStatus status = popFromConcurrentBufferWithReader(buffer, reader, &item);
+
+    TEST_ASSERT_NOT_EQUAL(BUFFER_OVERRUN, status);
+    if (status == BUFFER_OK)
+    {
+      TEST_ASSERT_EQUAL_UINT64(value, item.value);
+      value++;
+    }
+  }
+
+  pthread_join(producer, NULL);
+}
+
+void
+test_waitForItemsTimesOutOnEmptyBuffer(void)
+{
+  uint8_t reader;
+  getNewConcurrentBufferReaderDescriptor(buffer, &reader);
+
+  TEST_ASSERT_EQUAL(BUFFER_EMPTY, waitForItemsWithConcurrentReader(buffer, reader, 10));
+  TEST_ASSERT_EQUAL(BUFFER_INVALID_READER, waitForItemsWithConcurrentReader(buffer, reader + 1, 10));
+}
+
+void
+test_waitForItemsReturnsImmediatelyIfItemsArePending(void)
+{
+  uint8_t reader;
+  getNewConcurrentBufferReaderDescriptor(buffer, &reader);
+  pushValue(1);
+
+  TEST_ASSERT_EQUAL(BUFFER_OK, waitForItemsWithConcurrentReader(buffer, reader, 0));
+}
+
+#define WAITING_TEST_ITEMS (200)
+
+static void*
+produceItemsSlowly(void *argument)
+{
+  struct timespec pause = {0, 100000};
+
+  for (uint64_t value = 0; value < WAITING_TEST_ITEMS; value++)
+  {
+    nanosleep(&pause, NULL);
+    pushValue(value);
+  }
+
+  return NULL;
+}
+
+void
+test_waitingReaderIsWokenUpForEveryItem(void)
+{
+  uint8_t reader;
+  getNewConcurrentBufferReaderDescriptor(buffer, &reader);
+
+  pthread_t producer;
+  pthread_create(&producer, NULL, produceItemsSlowly, NULL);
+
+  CheckedItem item;
+  for (uint64_t value = 0; value < WAITING_TEST_ITEMS; value++)
+  {
+    TEST_ASSERT_EQUAL(BUFFER_OK, waitForItemsWithConcurrentReader(buffer, reader, 5000));
+    TEST_ASSERT_EQUAL(BUFFER_OK, popFromConcurrentBufferWithReader(buffer, reader, &item));
+    TEST_ASSERT_EQUAL_UINT64(value, item.value);
+  }
+
+  pthread_join(producer, NULL);
+}
+
+void
+test_multipleProducerBufferBehavesLikeSingleProducerBufferForOneThread(void)
+{
+  initConcurrentMultiReaderBufferWithOptions(buffer, sizeof(CheckedItem), MAX_ELEMENTS, MAX_READERS, MULTI_READER_BUFFER_MULTIPLE_PRODUCERS | MULTI_READER_BUFFER_REJECT_WHEN_FULL);
+  uint8_t reader;
+  getNewConcurrentBufferReaderDescriptor(buffer, &reader);
+
+  for (uint64_t value = 0; value < MAX_ELEMENTS; value++)
+  {
+    pushValue(value);
+  }
+
+  CheckedItem item = {0};
+  TEST_ASSERT_EQUAL(0, getFreeSpaceOfConcurrentBuffer(buffer));
+  TEST_ASSERT_EQUAL(BUFFER_FULL, pushToConcurrentBuffer(buffer, &item));
+
+  for (uint64_t value = 0; value < MAX_ELEMENTS; value++)
+  {
+    TEST_ASSERT_EQUAL(BUFFER_OK, popFromConcurrentBufferWithReader(buffer, reader, &item));
+    TEST_ASSERT_EQUAL_UINT64(value, item.value);
+  }
+  TEST_ASSERT_EQUAL(BUFFER_EMPTY, popFromConcurrentBufferWithReader(buffer, reader, &item));
+}
+
+#define NUMBER_OF_PRODUCERS (4)
+#define ITEMS_PER_PRODUCER (100000)
+
+static void*
+produceTaggedItems(void *argument)
+{
+  uint64_t producer = (uint64_t) (uintptr_t) argument;
+
+  for (uint64_t count = 0; count < ITEMS_PER_PRODUCER; count++)
+  {
+    pushValue(producer << 32 | count);  // Upper half tells the producer, lower half its item count
+  }
+
+  return NULL;
+}
+
+void
+test_itemsOfMultipleProducersArriveCompletelyAndInProducerOrder(void)
+{
+  initConcurrentMultiReaderBufferWithOptions(buffer, sizeof(CheckedItem), MAX_ELEMENTS, MAX_READERS, MULTI_READER_BUFFER_MULTIPLE_PRODUCERS | MULTI_READER_BUFFER_BLOCK_WHEN_FULL);
+  uint8_t reader;
+  getNewConcurrentBufferReaderDescriptor(buffer, &reader);
+
+  pthread_t producers[NUMBER_OF_PRODUCERS];
+  for (uintptr_t index = 0; index < NUMBER_OF_PRODUCERS; index++)
+  {
+    pthread_create(producers + index, NULL, produceTaggedItems, (void*) index);
+  }
+
+  uint64_t next_count[NUMBER_OF_PRODUCERS] = {0};
+  CheckedItem item;
+
+  for (uint64_t received = 0; received < NUMBER_OF_PRODUCERS * ITEMS_PER_PRODUCER;)
+  {
+    BufferStatus status = popFromConcurrentBufferWithReader(buffer, reader, &item);
+
+    TEST_ASSERT_NOT_EQUAL(BUFFER_OVERRUN, status);
+    if (status == BUFFER_OK)
+    {
+      uint64_t producer = item.value >> 32;
+
+      TEST_ASSERT_EQUAL_UINT64(~item.value, item.inverted_value);
+      TEST_ASSERT_TRUE(producer < NUMBER_OF_PRODUCERS);
+      TEST_ASSERT_EQUAL_UINT64(next_count[producer], item.value & 0xFFFFFFFF);
+      next_count[producer]++;
+      received++;
+    }
+    else
+    {
+      waitForItemsWithConcurrentReader(buffer, reader, 100);  // Leaves the CPU to the producers
+    }
+  }
+
+  for (size_t index = 0; index < NUMBER_OF_PRODUCERS; index++)
+  {
+    pthread_join(producers[index], NULL);
+  }
+  TEST_ASSERT_EQUAL(BUFFER_EMPTY, popFromConcurrentBufferWithReader(buffer, reader, &item));
+}
+
+void
+test_allClaimedItemsArePublishedOnceProducersHaveFinished(void)
+{
+  initConcurrentMultiReaderBufferWithOptions(buffer, sizeof(CheckedItem), MAX_ELEMENTS, MAX_READERS, MULTI_READER_BUFFER_MULTIPLE_PRODUCERS);
+
+  pthread_t producers[NUMBER_OF_PRODUCERS];
+  for (uintptr_t index = 0; index < NUMBER_OF_PRODUCERS; index++)
+  {
+    pthread_create(producers + index, NULL, produceTaggedItems, (void*) index);
+  }
+
+  for (size_t index = 0; index < NUMBER_OF_PRODUCERS; index++)
+  {
+    pthread_join(producers[index], NULL);
+  }
+
+  TEST_ASSERT_EQUAL_UINT64(NUMBER_OF_PRODUCERS * ITEMS_PER_PRODUCER, atomic_load(&buffer->claim_sequence));
+  TEST_ASSERT_EQUAL_UINT64(atomic_load(&buffer->claim_sequence), atomic_load(&buffer->write_sequence));
+}
+
+#define STRESS_TEST_ITEMS (2000000)
+
+typedef struct ConsumerResult
+{
+  uint8_t reader;
+  uint64_t items_read;
+  uint64_t overruns;
+  bool corrupted;
+  bool out_of_order;
+  bool items_lost_silently;
+} ConsumerResult;
+
+static void*
+consumeUntilLastItem(void *argument)
+{
+  ConsumerResult *result = (ConsumerResult*) argument;
+  uint64_t expected_value = 0;
+  bool overrun_reported = false;
+  CheckedItem item;
+
+  while (expected_value < STRESS_TEST_ITEMS)
+  {
+    BufferStatus status = popFromConcurrentBufferWithReader(buffer, result->reader, &item);
+
+    if (status == BUFFER_OK)
+    {
+      result->corrupted |= (item.inverted_value != ~item.value);
+      result->out_of_order |= (item.value < expected_value);
+      result->items_lost_silently |= (item.value != expected_value && !overrun_reported);
+      expected_value = item.value + 1;
+      overrun_reported = false;
+      result->items_read++;
+    }
+    else if (status == BUFFER_OVERRUN)
+    {
+      result->overruns++;
+      overrun_reported = true;
+    }
+  }
+
+  return NULL;
+}
+
+void
+test_stressOneProducerAndSeveralConsumers(void)
+{
+  pthread_t consumers[MAX_READERS];
+  ConsumerResult results[MAX_READERS] = {{0}};
+
+  for (uint8_t index = 0; index < MAX_READERS; index++)
+  {
+    getNewConcurrentBufferReaderDescriptor(buffer, &results[index].reader);
+    pthread_create(consumers + index, NULL, consumeUntilLastItem, results + index);
+  }
+
+  for (uint64_t value = 0; value < STRESS_TEST_ITEMS; value++)
+  {
+    pushValue(value);
+  }
+
+  for (uint8_t index = 0; index < MAX_READERS; index++)
+  {
+    pthread_join(consumers[index], NULL);
+    TEST_ASSERT_FALSE(results[index].corrupted);
+    TEST_ASSERT_FALSE(results[index].out_of_order);
+    TEST_ASSERT_FALSE(results[index].items_lost_silently);
+    TEST_ASSERT_TRUE(results[index].items_read > 0);
+  }
+}
+
+void
+test_groupHandsEachItemToOneConsumerWhileOthersSeeAll(void)
+{
+  uint8_t group, other_group, reader;
+  getNewConcurrentBufferGroupDescriptor(buffer, &group);
+  getNewConcurrentBufferGroupDescriptor(buffer, &other_group);
+  getNewConcurrentBufferReaderDescriptor(buffer, &reader);
+
+  for (uint64_t value = 0; value < 4; value++)
+  {
+    pushValue(value);
+  }
+
+  CheckedItem item;
+  for (uint64_t value = 0; value < 4; value++)
+  {
+    TEST_ASSERT_EQUAL(BUFFER_OK, popFromConcurrentBufferWithReader(buffer, group, &item));
+    TEST_ASSERT_EQUAL_UINT64(value, item.value);
+  }
+  TEST_ASSERT_EQUAL(BUFFER_EMPTY, popFromConcurrentBufferWithReader(buffer, group, &item));
+
+  for (uint64_t value = 0; value < 4; value++)
+  {
+    TEST_ASSERT_EQUAL(BUFFER_OK, popFromConcurrentBufferWithReader(buffer, other_group, &item));
+    TEST_ASSERT_EQUAL_UINT64(value, item.value);
+    TEST_ASSERT_EQUAL(BUFFER_OK, popFromConcurrentBufferWithReader(buffer, reader, &item));
+    TEST_ASSERT_EQUAL_UINT64(value, item.value);
+  }
+}
+
+void
+test_overrunGroupContinuesWithOldestItem(void)
+{
+  uint8_t group;
+  getNewConcurrentBufferGroupDescriptor(buffer, &group);
+
+  for (uint64_t value = 0; value < MAX_ELEMENTS + 5; value++)
+  {
+    pushValue(value);
+  }
+
+  CheckedItem item;
+  TEST_ASSERT_EQUAL(BUFFER_OVERRUN, popFromConcurrentBufferWithReader(buffer, group, &item));
+  TEST_ASSERT_EQUAL(BUFFER_OK, popFromConcurrentBufferWithReader(buffer, group, &item));
+  TEST_ASSERT_EQUAL_UINT64(5, item.value);
+}
+
+void
+test_seekReaderToSequenceNumber(void)
+{
+  uint8_t reader;
+  getNewConcurrentBufferReaderDescriptor(buffer, &reader);
+
+  for (uint64_t value = 0; value < MAX_ELEMENTS + 5; value++)
+  {
+    pushValue(value);
+  }
+
+  CheckedItem item;
+  uint64_t sequence_number;
+  TEST_ASSERT_EQUAL(BUFFER_EVICTED, seekConcurrentBufferReaderToSequenceNumber(buffer, reader, 4));
+  TEST_ASSERT_EQUAL(BUFFER_EMPTY, seekConcurrentBufferReaderToSequenceNumber(buffer, reader, MAX_ELEMENTS + 6));
+  TEST_ASSERT_EQUAL(BUFFER_OK, seekConcurrentBufferReaderToSequenceNumber(buffer, reader, 40));
+  TEST_ASSERT_EQUAL(BUFFER_OK, popFromConcurrentBufferWithReader(buffer, reader, &item));
+  TEST_ASSERT_EQUAL_UINT64(40, item.value);
+  TEST_ASSERT_EQUAL(BUFFER_OK, getConcurrentBufferReaderSequenceNumber(buffer, reader, &sequence_number));
+  TEST_ASSERT_EQUAL_UINT64(41, sequence_number);
+  TEST_ASSERT_EQUAL(BUFFER_INVALID_READER, seekConcurrentBufferReaderToSequenceNumber(buffer, reader + 1, 40));
+}
+
+#define GROUP_TEST_ITEMS (200000)
+#define NUMBER_OF_GROUP_CONSUMERS (3)
+
+typedef struct GroupConsumerResult
+{
+  uint8_t group;
+  uint64_t items_read;
+  bool corrupted;
+} GroupConsumerResult;
+
+static _Atomic uint8_t times_received[GROUP_TEST_ITEMS];
+static _Atomic uint64_t group_items_read;
+
+static void*
+consumeAsGroupMember(void *argument)
+{
+  GroupConsumerResult *result = (GroupConsumerResult*) argument;
+  CheckedItem item;
+
+  while (atomic_load(&group_items_read) < GROUP_TEST_ITEMS)
+  {
+    if (popFromConcurrentBufferWithReader(buffer, result->group, &item) == BUFFER_OK)
+    {
+      result->corrupted |= (item.inverted_value != ~item.value) || item.value >= GROUP_TEST_ITEMS;
+      if (!result->corrupted)
+      {
+        atomic_fetch_add(times_received + item.value, 1);
+      }
+      atomic_fetch_add(&group_items_read, 1);
+      result->items_read++;
+    }
+    else
+    {
+      waitForItemsWithConcurrentReader(buffer, result->group, 10);
+    }
+  }
+
+  return NULL;
+}
+
+static void*
+consumeAllGroupTestItems(void *argument)
+{
+  ConsumerResult *result = (ConsumerResult*) argument;
+  CheckedItem item;
+
+  while (result->items_read + result->overruns < GROUP_TEST_ITEMS)
+  {
+    BufferStatus status = popFromConcurrentBufferWithReader(buffer, result->reader, &item);
+
+    if (status == BUFFER_OK)
+    {
+      result->corrupted |= (item.inverted_value != ~item.value);
+      result->out_of_order |= (item.value != result->items_read);
+      result->items_read++;
+    }
+    else if (status == BUFFER_OVERRUN)
+    {
+      result->overruns++;
+    }
+    else
+    {
+      waitForItemsWithConcurrentReader(buffer, result->reader, 10);
+    }
+  }
+
+  return NULL;
+}
+
+void
+test_groupConsumersShareItemsWhileReaderSeesAll(void)
+{
+  initConcurrentMultiReaderBufferWithOptions(buffer, sizeof(CheckedItem), MAX_ELEMENTS, MAX_READERS, MULTI_READER_BUFFER_BLOCK_WHEN_FULL);
+  atomic_store(&group_items_read, 0);
+  for (size_t value = 0; value < GROUP_TEST_ITEMS; value++)
+  {
+    atomic_store(times_received + value, 0);
+  }
+
+  uint8_t group;
+  getNewConcurrentBufferGroupDescriptor(buffer, &group);
+
+  pthread_t consumers[NUMBER_OF_GROUP_CONSUMERS];
+  GroupConsumerResult results[NUMBER_OF_GROUP_CONSUMERS] = {{0}};
+  for (size_t index = 0; index < NUMBER_OF_GROUP_CONSUMERS; index++)
+  {
+    results[index].group = group;
+    pthread_create(consumers + index, NULL, consumeAsGroupMember, results + index);
+  }
+
+  ConsumerResult broadcast_result = {0};
+  pthread_t broadcast_consumer;
+  getNewConcurrentBufferReaderDescriptor(buffer, &broadcast_result.reader);
+  pthread_create(&broadcast_consumer, NULL, consumeAllGroupTestItems, &broadcast_result);
+
+  for (uint64_t value = 0; value < GROUP_TEST_ITEMS; value++)
+  {
+    pushValue(value);
+  }
+
+  pthread_join(broadcast_consumer, NULL);
+  TEST_ASSERT_EQUAL_UINT64(GROUP_TEST_ITEMS, broadcast_result.items_read);
+  TEST_ASSERT_EQUAL_UINT64(0, broadcast_result.overruns);
+  TEST_ASSERT_FALSE(broadcast_result.corrupted);
+  TEST_ASSERT_FALSE(broadcast_result.out_of_order);
+
+  for (size_t index = 0; index < NUMBER_OF_GROUP_CONSUMERS; index++)
+  {
+    pthread_join(consumers[index], NULL);
+    TEST_ASSERT_FALSE(results[index].corrupted);
+  }
+  for (size_t value = 0; value < GROUP_TEST_ITEMS; value++)
+  {
+    TEST_ASSERT_EQUAL_UINT8(1, atomic_load(times_received + value));
+  }
+}
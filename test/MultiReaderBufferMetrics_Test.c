@@ -0,0 +1,115 @@
+#include <unity.h>
+#include <CException.h>
+#include "EmbeddedUtilities/MultiReaderBuffer.h"
+
+/*
+ * Needs the buffer built with -DMULTI_READER_BUFFER_METRICS=1,
+ * see the MultiReaderBufferMetrics target.
+ */
+
+#define BUFFER_WORD_SIZE (2)
+#define MAX_ELEMENTS (50)
+#define MAX_READERS (5)
+
+static uint8_t raw_memory_circular_buffer[MULTI_READER_BUFFER_SIZE(BUFFER_WORD_SIZE, MAX_ELEMENTS, MAX_READERS)];
+static Buffer *buffer = (Buffer*) &raw_memory_circular_buffer;
+static MultiReaderBuffer *circular_buffer = (MultiReaderBuffer*) &raw_memory_circular_buffer;
+
+void
+setUp(void)
+{
+  initMultiReaderBuffer(circular_buffer, BUFFER_WORD_SIZE, MAX_ELEMENTS, MAX_READERS);
+}
+
+void
+test_readerMetricsCountConsumedAndDroppedElementsAndLag(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+  BufferReaderMetrics metrics;
+
+  uint16_t input = 0;
+  for (; input < 10; input++)
+  {
+    pushToBuffer(buffer, &input);
+  }
+  popFromBufferWithReader(buffer, reader);
+  consumeWithReader(buffer, reader, 4);
+
+  getBufferReaderMetrics(buffer, reader, &metrics);
+  TEST_ASSERT_EQUAL_UINT64(5, metrics.consumed_elements);
+  TEST_ASSERT_EQUAL_UINT64(0, metrics.dropped_elements);
+  TEST_ASSERT_EQUAL(10, metrics.max_lag);
+  TEST_ASSERT_EQUAL(5, metrics.current_lag);
+
+  for (; input < MAX_ELEMENTS + 13; input++)
+  {
+    pushToBuffer(buffer, &input);
+  }
+
+  getBufferReaderMetrics(buffer, reader, &metrics);
+  TEST_ASSERT_EQUAL_UINT64(8, metrics.dropped_elements);
+  TEST_ASSERT_EQUAL(MAX_ELEMENTS, metrics.max_lag);
+  TEST_ASSERT_EQUAL(MAX_ELEMENTS, metrics.current_lag);
+}
+
+void
+test_bufferMetricsCountPushedAndRejectedElementsAndMaximumFill(void)
+{
+  initMultiReaderBufferWithOptions(circular_buffer, BUFFER_WORD_SIZE, MAX_ELEMENTS, MAX_READERS, MULTI_READER_BUFFER_REJECT_WHEN_FULL);
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+  uint16_t burst[MAX_ELEMENTS] = {0};
+  BufferMetrics metrics;
+
+  pushManyToBuffer(buffer, burst, 30);
+  consumeWithReader(buffer, reader, 30);
+  pushManyToBuffer(buffer, burst, 20);
+  pushManyToBuffer(buffer, burst, 40);
+
+  getBufferMetrics(buffer, &metrics);
+  TEST_ASSERT_EQUAL_UINT64(50, metrics.pushed_elements);
+  TEST_ASSERT_EQUAL_UINT64(40, metrics.rejected_elements);
+  TEST_ASSERT_EQUAL(30, metrics.max_fill);
+}
+
+void
+test_getReaderMetricsWithInvalidReaderThrowsException(void)
+{
+  BufferReaderMetrics metrics;
+  CEXCEPTION_T e;
+
+  Try
+  {
+    getBufferReaderMetrics(buffer, 0, &metrics);
+    TEST_FAIL_MESSAGE("Exception not thrown!");
+  }
+  Catch (e)
+  {
+    TEST_ASSERT_EQUAL_HEX32(BUFFER_INVALID_READER_EXCEPTION, e);
+  }
+}
+
+#define POWER_OF_TWO_MAX_ELEMENTS (16)
+
+void
+test_lagOfLappedPowerOfTwoReaderIsLimitedToCapacity(void)
+{
+  initMultiReaderBufferWithOptions(circular_buffer, BUFFER_WORD_SIZE, POWER_OF_TWO_MAX_ELEMENTS, MAX_READERS, MULTI_READER_BUFFER_POWER_OF_TWO_CAPACITY);
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+  BufferReaderMetrics reader_metrics;
+  BufferMetrics metrics;
+
+  for (uint16_t input = 0; input < 3 * POWER_OF_TWO_MAX_ELEMENTS; input++)
+  {
+    pushToBuffer(buffer, &input);
+  }
+
+  const void *item;
+  TEST_ASSERT_EQUAL(BUFFER_OVERRUN, tryPopFromBufferWithReader(buffer, reader, &item));
+
+  getBufferReaderMetrics(buffer, reader, &reader_metrics);
+  TEST_ASSERT_EQUAL_UINT64(2 * POWER_OF_TWO_MAX_ELEMENTS, reader_metrics.dropped_elements);
+  TEST_ASSERT_EQUAL(POWER_OF_TWO_MAX_ELEMENTS, reader_metrics.max_lag);
+
+  getBufferMetrics(buffer, &metrics);
+  TEST_ASSERT_EQUAL(POWER_OF_TWO_MAX_ELEMENTS, metrics.max_fill);
+}
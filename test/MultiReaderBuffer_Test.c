@@ -1,5 +1,6 @@
 #include <unity.h>
 #include <CException.h>
+#include <string.h>
 #include "EmbeddedUtilities/MultiReaderBuffer.h"
 
 #define BUFFER_WORD_SIZE (2)
@@ -458,3 +459,1127 @@ test_noReadableItemsExistForReaderWhenNothingHasBeenWritten(void)
   TEST_ASSERT_FALSE(readable_items_exist);
 }
 
+
+void
+test_pushManyPopInSameOrder(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+
+  uint16_t input[] = {3, 1, 4, 1, 5};
+  pushManyToBuffer(buffer, input, 5);
+
+  for (uint8_t index = 0; index < 5; index++)
+  {
+    uint16_t output = *((uint16_t*) popFromBufferWithReader(buffer, reader));
+    TEST_ASSERT_EQUAL(input[index], output);
+  }
+
+  TEST_ASSERT_FALSE(readableItemExistsForReader(buffer, reader));
+}
+
+void
+test_pushManyAcrossWraparound(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+
+  uint16_t input = 0;
+  for (uint8_t times = 0; times < MAX_ELEMENTS - 2; times++)
+  {
+    pushToBuffer(buffer, &input);
+    popFromBufferWithReader(buffer, reader);
+  }
+
+  uint16_t burst[10];
+  for (uint8_t index = 0; index < 10; index++)
+  {
+    burst[index] = index + 100;
+  }
+  pushManyToBuffer(buffer, burst, 10);
+
+  for (uint8_t index = 0; index < 10; index++)
+  {
+    uint16_t output = *((uint16_t*) popFromBufferWithReader(buffer, reader));
+    TEST_ASSERT_EQUAL(burst[index], output);
+  }
+}
+
+void
+test_pushManyOverrunsReaderLikeSinglePushes(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+
+  uint16_t burst[MAX_ELEMENTS + 3];
+  for (uint8_t index = 0; index < MAX_ELEMENTS + 3; index++)
+  {
+    burst[index] = index;
+  }
+  pushManyToBuffer(buffer, burst, MAX_ELEMENTS + 3);
+
+  CEXCEPTION_T e;
+
+  Try
+  {
+    popFromBufferWithReader(buffer, reader);
+    TEST_FAIL_MESSAGE("Exception not thrown!");
+  }
+  Catch (e)
+  {
+    TEST_ASSERT_EQUAL_HEX32(BUFFER_OVERRUN_EXCEPTION, e);
+  }
+
+  for (uint8_t index = 3; index < MAX_ELEMENTS + 3; index++)
+  {
+    uint16_t output = *((uint16_t*) popFromBufferWithReader(buffer, reader));
+    TEST_ASSERT_EQUAL(index, output);
+  }
+
+  TEST_ASSERT_FALSE(readableItemExistsForReader(buffer, reader));
+}
+
+void
+test_pushManyDoesNotOverrunReaderWithEnoughSpaceLeft(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+
+  uint16_t burst[MAX_ELEMENTS];
+  for (uint8_t index = 0; index < MAX_ELEMENTS; index++)
+  {
+    burst[index] = index;
+  }
+  pushManyToBuffer(buffer, burst, MAX_ELEMENTS / 2);
+  popFromBufferWithReader(buffer, reader);
+  pushManyToBuffer(buffer, burst, MAX_ELEMENTS / 2 + 1);
+
+  CEXCEPTION_T e;
+
+  Try
+  {
+    uint16_t output = *((uint16_t*) popFromBufferWithReader(buffer, reader));
+    TEST_ASSERT_EQUAL(1, output);
+  }
+  Catch (e)
+  {
+    TEST_FAIL_MESSAGE("Exception thrown!");
+  }
+}
+
+void
+test_reserveAndCommitMakesItemsReadable(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+
+  size_t reserved = 0;
+  uint16_t *slots = (uint16_t*) reserveBufferSpace(buffer, 3, &reserved);
+  TEST_ASSERT_EQUAL(3, reserved);
+
+  slots[0] = 7;
+  slots[1] = 8;
+  slots[2] = 9;
+
+  TEST_ASSERT_FALSE(readableItemExistsForReader(buffer, reader));
+
+  commitBufferSpace(buffer, 3);
+
+  for (uint16_t expected = 7; expected <= 9; expected++)
+  {
+    uint16_t output = *((uint16_t*) popFromBufferWithReader(buffer, reader));
+    TEST_ASSERT_EQUAL(expected, output);
+  }
+}
+
+void
+test_reserveStopsAtWraparound(void)
+{
+  uint16_t input = 0;
+  for (uint8_t times = 0; times < MAX_ELEMENTS - 1; times++)
+  {
+    pushToBuffer(buffer, &input);
+  }
+
+  size_t reserved = 0;
+  reserveBufferSpace(buffer, 10, &reserved);
+  TEST_ASSERT_EQUAL(2, reserved);
+}
+
+void
+test_commitLessThanReserved(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+
+  size_t reserved = 0;
+  uint16_t *slots = (uint16_t*) reserveBufferSpace(buffer, 4, &reserved);
+  slots[0] = 42;
+  commitBufferSpace(buffer, 1);
+
+  uint16_t output = *((uint16_t*) popFromBufferWithReader(buffer, reader));
+  TEST_ASSERT_EQUAL(42, output);
+  TEST_ASSERT_FALSE(readableItemExistsForReader(buffer, reader));
+}
+
+void
+test_commitMoreThanReservedThrowsException(void)
+{
+  size_t reserved = 0;
+  reserveBufferSpace(buffer, 2, &reserved);
+
+  CEXCEPTION_T e;
+
+  Try
+  {
+    commitBufferSpace(buffer, 3);
+    TEST_FAIL_MESSAGE("Exception not thrown!");
+  }
+  Catch (e)
+  {
+    TEST_ASSERT_EQUAL_HEX32(BUFFER_INVALID_COMMIT_EXCEPTION, e);
+  }
+}
+
+void
+test_reserveOverrunsReaderWhoseItemsWouldBeOverwritten(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+
+  uint16_t input = 0;
+  for (; input < MAX_ELEMENTS - 1; input++)
+  {
+    pushToBuffer(buffer, &input);
+  }
+
+  size_t reserved = 0;
+  uint16_t *slots = (uint16_t*) reserveBufferSpace(buffer, 2, &reserved);
+  slots[0] = 100;
+  slots[1] = 101;
+  commitBufferSpace(buffer, 2);
+
+  CEXCEPTION_T e;
+
+  Try
+  {
+    popFromBufferWithReader(buffer, reader);
+    TEST_FAIL_MESSAGE("Exception not thrown!");
+  }
+  Catch (e)
+  {
+    TEST_ASSERT_EQUAL_HEX32(BUFFER_OVERRUN_EXCEPTION, e);
+  }
+
+  uint16_t output = *((uint16_t*) popFromBufferWithReader(buffer, reader));
+  TEST_ASSERT_EQUAL(1, output);
+}
+
+void
+test_peekSpanOfEmptyBufferIsEmpty(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+  BufferSpan span;
+  TEST_ASSERT_EQUAL(0, peekSpanWithReader(buffer, reader, &span));
+  TEST_ASSERT_EQUAL(0, span.first_length);
+  TEST_ASSERT_EQUAL(0, span.second_length);
+}
+
+void
+test_peekSpanWithoutWraparound(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+
+  uint16_t input[] = {1, 2, 3};
+  pushManyToBuffer(buffer, input, 3);
+
+  BufferSpan span;
+  TEST_ASSERT_EQUAL(3, peekSpanWithReader(buffer, reader, &span));
+  TEST_ASSERT_EQUAL(3, span.first_length);
+  TEST_ASSERT_EQUAL(0, span.second_length);
+  TEST_ASSERT_EQUAL_MEMORY(input, span.first, sizeof(input));
+}
+
+void
+test_peekSpanAcrossWraparoundAndConsume(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+
+  uint16_t input = 0;
+  for (; input < MAX_ELEMENTS - 1; input++)
+  {
+    pushToBuffer(buffer, &input);
+  }
+  consumeWithReader(buffer, reader, MAX_ELEMENTS - 1);
+
+  for (; input < MAX_ELEMENTS + 4; input++)
+  {
+    pushToBuffer(buffer, &input);
+  }
+
+  BufferSpan span;
+  TEST_ASSERT_EQUAL(5, peekSpanWithReader(buffer, reader, &span));
+  TEST_ASSERT_EQUAL(2, span.first_length);
+  TEST_ASSERT_EQUAL(3, span.second_length);
+  TEST_ASSERT_EQUAL(MAX_ELEMENTS - 1, ((const uint16_t*) span.first)[0]);
+  TEST_ASSERT_EQUAL(MAX_ELEMENTS + 1, ((const uint16_t*) span.second)[0]);
+
+  consumeWithReader(buffer, reader, 4);
+
+  uint16_t output = *((uint16_t*) popFromBufferWithReader(buffer, reader));
+  TEST_ASSERT_EQUAL(MAX_ELEMENTS + 3, output);
+  TEST_ASSERT_FALSE(readableItemExistsForReader(buffer, reader));
+}
+
+void
+test_consumeMoreThanUnreadThrowsUnderrunException(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+
+  uint16_t input[] = {1, 2};
+  pushManyToBuffer(buffer, input, 2);
+
+  CEXCEPTION_T e;
+
+  Try
+  {
+    consumeWithReader(buffer, reader, 3);
+    TEST_FAIL_MESSAGE("Exception not thrown!");
+  }
+  Catch (e)
+  {
+    TEST_ASSERT_EQUAL_HEX32(BUFFER_UNDERRUN_EXCEPTION, e);
+  }
+}
+
+void
+test_peekSpanThrowsOverrunExceptionWhenReaderHasBeenOverwritten(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+
+  uint16_t input = 0;
+  for (; input < MAX_ELEMENTS + 1; input++)
+  {
+    pushToBuffer(buffer, &input);
+  }
+
+  BufferSpan span;
+  CEXCEPTION_T e;
+
+  Try
+  {
+    peekSpanWithReader(buffer, reader, &span);
+    TEST_FAIL_MESSAGE("Exception not thrown!");
+  }
+  Catch (e)
+  {
+    TEST_ASSERT_EQUAL_HEX32(BUFFER_OVERRUN_EXCEPTION, e);
+  }
+
+  TEST_ASSERT_EQUAL(MAX_ELEMENTS, peekSpanWithReader(buffer, reader, &span));
+  TEST_ASSERT_EQUAL(1, ((const uint16_t*) span.first)[0]);
+}
+
+#define POWER_OF_TWO_MAX_ELEMENTS (16)
+
+static uint8_t raw_memory_power_of_two_buffer[MULTI_READER_BUFFER_SIZE(BUFFER_WORD_SIZE, POWER_OF_TWO_MAX_ELEMENTS, MAX_READERS)];
+static Buffer *power_of_two_buffer = (Buffer*) &raw_memory_power_of_two_buffer;
+
+static void
+initPowerOfTwoBuffer(void)
+{
+  initMultiReaderBufferWithOptions((MultiReaderBuffer*) power_of_two_buffer, BUFFER_WORD_SIZE, POWER_OF_TWO_MAX_ELEMENTS, MAX_READERS, MULTI_READER_BUFFER_POWER_OF_TWO_CAPACITY);
+}
+
+void
+test_initWithPowerOfTwoOptionThrowsExceptionForOtherCapacities(void)
+{
+  CEXCEPTION_T e;
+
+  Try
+  {
+    initMultiReaderBufferWithOptions(circular_buffer, BUFFER_WORD_SIZE, MAX_ELEMENTS, MAX_READERS, MULTI_READER_BUFFER_POWER_OF_TWO_CAPACITY);
+    TEST_FAIL_MESSAGE("Exception not thrown!");
+  }
+  Catch (e)
+  {
+    TEST_ASSERT_EQUAL_HEX32(BUFFER_INVALID_CAPACITY_EXCEPTION, e);
+  }
+}
+
+void
+test_powerOfTwoBufferHoldsAllElementsWithoutOverrun(void)
+{
+  initPowerOfTwoBuffer();
+  uint8_t reader = getNewBufferReaderDescriptor(power_of_two_buffer);
+
+  for (uint16_t input = 0; input < POWER_OF_TWO_MAX_ELEMENTS; input++)
+  {
+    pushToBuffer(power_of_two_buffer, &input);
+  }
+
+  for (uint16_t expected = 0; expected < POWER_OF_TWO_MAX_ELEMENTS; expected++)
+  {
+    TEST_ASSERT_EQUAL(expected, *((const uint16_t*) popFromBufferWithReader(power_of_two_buffer, reader)));
+  }
+  TEST_ASSERT_FALSE(readableItemExistsForReader(power_of_two_buffer, reader));
+}
+
+void
+test_powerOfTwoBufferReportsExactNumberOfLostElements(void)
+{
+  initPowerOfTwoBuffer();
+  uint8_t reader = getNewBufferReaderDescriptor(power_of_two_buffer);
+
+  uint16_t input = 0;
+  for (; input < 3 * POWER_OF_TWO_MAX_ELEMENTS + 5; input++)
+  {
+    pushToBuffer(power_of_two_buffer, &input);
+  }
+
+  CEXCEPTION_T e;
+
+  Try
+  {
+    popFromBufferWithReader(power_of_two_buffer, reader);
+    TEST_FAIL_MESSAGE("Exception not thrown!");
+  }
+  Catch (e)
+  {
+    TEST_ASSERT_EQUAL_HEX32(BUFFER_OVERRUN_EXCEPTION, e);
+  }
+
+  TEST_ASSERT_EQUAL(2 * POWER_OF_TWO_MAX_ELEMENTS + 5, getNumberOfLostElementsForReader(power_of_two_buffer, reader));
+  TEST_ASSERT_EQUAL(2 * POWER_OF_TWO_MAX_ELEMENTS + 5, *((const uint16_t*) popFromBufferWithReader(power_of_two_buffer, reader)));
+}
+
+void
+test_powerOfTwoBufferCountsElementsLostByBatchPushesOnce(void)
+{
+  initPowerOfTwoBuffer();
+  uint8_t reader = getNewBufferReaderDescriptor(power_of_two_buffer);
+
+  uint16_t burst[2 * POWER_OF_TWO_MAX_ELEMENTS];
+  for (uint16_t index = 0; index < 2 * POWER_OF_TWO_MAX_ELEMENTS; index++)
+  {
+    burst[index] = index;
+  }
+
+  pushManyToBuffer(power_of_two_buffer, burst, POWER_OF_TWO_MAX_ELEMENTS - 4);
+  pushManyToBuffer(power_of_two_buffer, burst + POWER_OF_TWO_MAX_ELEMENTS - 4, 10);
+  pushManyToBuffer(power_of_two_buffer, burst + POWER_OF_TWO_MAX_ELEMENTS + 6, POWER_OF_TWO_MAX_ELEMENTS - 6);
+
+  CEXCEPTION_T e;
+
+  Try
+  {
+    popFromBufferWithReader(power_of_two_buffer, reader);
+    TEST_FAIL_MESSAGE("Exception not thrown!");
+  }
+  Catch (e)
+  {
+    TEST_ASSERT_EQUAL_HEX32(BUFFER_OVERRUN_EXCEPTION, e);
+  }
+
+  TEST_ASSERT_EQUAL(POWER_OF_TWO_MAX_ELEMENTS, getNumberOfLostElementsForReader(power_of_two_buffer, reader));
+  TEST_ASSERT_EQUAL(POWER_OF_TWO_MAX_ELEMENTS, *((const uint16_t*) popFromBufferWithReader(power_of_two_buffer, reader)));
+}
+
+void
+test_powerOfTwoBufferCountsOnlyCommittedElementsAsLost(void)
+{
+  initPowerOfTwoBuffer();
+  uint8_t reader = getNewBufferReaderDescriptor(power_of_two_buffer);
+
+  for (uint16_t input = 0; input < POWER_OF_TWO_MAX_ELEMENTS; input++)
+  {
+    pushToBuffer(power_of_two_buffer, &input);
+  }
+
+  size_t reserved;
+  uint16_t *slots = (uint16_t*) reserveBufferSpace(power_of_two_buffer, 8, &reserved);
+  slots[0] = 100;
+  slots[1] = 101;
+  commitBufferSpace(power_of_two_buffer, 2);
+
+  CEXCEPTION_T e;
+
+  Try
+  {
+    popFromBufferWithReader(power_of_two_buffer, reader);
+    TEST_FAIL_MESSAGE("Exception not thrown!");
+  }
+  Catch (e)
+  {
+    TEST_ASSERT_EQUAL_HEX32(BUFFER_OVERRUN_EXCEPTION, e);
+  }
+
+  TEST_ASSERT_EQUAL(2, getNumberOfLostElementsForReader(power_of_two_buffer, reader));
+  TEST_ASSERT_EQUAL(2, *((const uint16_t*) popFromBufferWithReader(power_of_two_buffer, reader)));
+}
+
+static void
+checkReaderSkipsSlotsOfOpenReservation(Buffer *target, uint16_t max_elements)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(target);
+
+  for (uint16_t input = 0; input < max_elements; input++)
+  {
+    pushToBuffer(target, &input);
+  }
+
+  size_t reserved;
+  uint16_t *slots = (uint16_t*) reserveBufferSpace(target, 4, &reserved);  // Fewer slots until the wrap-around in default mode
+  slots[0] = 100;
+
+  const void *item;
+  TEST_ASSERT_EQUAL(BUFFER_OVERRUN, tryPopFromBufferWithReader(target, reader, &item));
+  TEST_ASSERT_EQUAL(reserved, getNumberOfLostElementsForReader(target, reader));
+  TEST_ASSERT_EQUAL(BUFFER_OK, tryPopFromBufferWithReader(target, reader, &item));
+  TEST_ASSERT_EQUAL(reserved, *((const uint16_t*) item));
+
+  commitBufferSpace(target, reserved);
+  TEST_ASSERT_EQUAL(BUFFER_OK, tryPopFromBufferWithReader(target, reader, &item));
+  TEST_ASSERT_EQUAL(reserved + 1, *((const uint16_t*) item));
+}
+
+void
+test_readerDoesNotSeeSlotsOfOpenReservation(void)
+{
+  checkReaderSkipsSlotsOfOpenReservation(buffer, MAX_ELEMENTS);
+}
+
+void
+test_powerOfTwoReaderDoesNotSeeSlotsOfOpenReservation(void)
+{
+  initPowerOfTwoBuffer();
+  checkReaderSkipsSlotsOfOpenReservation(power_of_two_buffer, POWER_OF_TWO_MAX_ELEMENTS);
+}
+
+void
+test_powerOfTwoBufferSpanAcrossWraparound(void)
+{
+  initPowerOfTwoBuffer();
+  uint8_t reader = getNewBufferReaderDescriptor(power_of_two_buffer);
+
+  uint16_t input = 0;
+  for (; input < POWER_OF_TWO_MAX_ELEMENTS - 2; input++)
+  {
+    pushToBuffer(power_of_two_buffer, &input);
+  }
+  consumeWithReader(power_of_two_buffer, reader, POWER_OF_TWO_MAX_ELEMENTS - 2);
+
+  uint16_t burst[5] = {100, 101, 102, 103, 104};
+  pushManyToBuffer(power_of_two_buffer, burst, 5);
+
+  BufferSpan span;
+  TEST_ASSERT_EQUAL(5, peekSpanWithReader(power_of_two_buffer, reader, &span));
+  TEST_ASSERT_EQUAL(2, span.first_length);
+  TEST_ASSERT_EQUAL(3, span.second_length);
+  TEST_ASSERT_EQUAL(101, ((const uint16_t*) span.first)[1]);
+  TEST_ASSERT_EQUAL(102, ((const uint16_t*) span.second)[0]);
+}
+
+void
+test_lostElementsOfDefaultBufferAreCountedPerOverwrittenItem(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+
+  uint16_t input = 0;
+  for (; input < MAX_ELEMENTS + 4; input++)
+  {
+    pushToBuffer(buffer, &input);
+  }
+
+  TEST_ASSERT_EQUAL(4, getNumberOfLostElementsForReader(buffer, reader));
+}
+
+#define LARGE_WORD_SIZE (1000)
+#define LARGE_MAX_ELEMENTS (4096)
+
+static uint8_t raw_memory_large_buffer[MULTI_READER_BUFFER_SIZE(LARGE_WORD_SIZE, LARGE_MAX_ELEMENTS, MAX_READERS)];
+static Buffer *large_buffer = (Buffer*) &raw_memory_large_buffer;
+
+typedef struct LargeRecord
+{
+  uint32_t sequence;
+  uint8_t payload[LARGE_WORD_SIZE - sizeof(uint32_t)];
+} LargeRecord;
+
+static void
+fillLargeRecord(LargeRecord *record, uint32_t sequence)
+{
+  record->sequence = sequence;
+  memset(record->payload, (uint8_t) sequence, sizeof(record->payload));
+}
+
+void
+test_initZeroesBufferOfSeveralMegabytes(void)
+{
+  memset(raw_memory_large_buffer, 0xAA, sizeof(raw_memory_large_buffer));
+  initMultiReaderBuffer((MultiReaderBuffer*) large_buffer, LARGE_WORD_SIZE, LARGE_MAX_ELEMENTS, MAX_READERS);
+
+  size_t reserved = 0;
+  const uint8_t *storage = (const uint8_t*) reserveBufferSpace(large_buffer, LARGE_MAX_ELEMENTS, &reserved);
+
+  TEST_ASSERT_EQUAL(LARGE_MAX_ELEMENTS, reserved);
+  TEST_ASSERT_EQUAL(0, storage[0]);
+  TEST_ASSERT_EQUAL(0, storage[LARGE_WORD_SIZE * LARGE_MAX_ELEMENTS - 1]);
+}
+
+void
+test_initWithSkipZeroingLeavesBufferContent(void)
+{
+  memset(raw_memory_large_buffer, 0xAA, sizeof(raw_memory_large_buffer));
+  initMultiReaderBufferWithOptions((MultiReaderBuffer*) large_buffer, LARGE_WORD_SIZE, LARGE_MAX_ELEMENTS, MAX_READERS, MULTI_READER_BUFFER_SKIP_ZEROING);
+
+  TEST_ASSERT_FALSE(readableItemExistsForReader(large_buffer, getNewBufferReaderDescriptor(large_buffer)));
+
+  size_t reserved = 0;
+  const uint8_t *storage = (const uint8_t*) reserveBufferSpace(large_buffer, LARGE_MAX_ELEMENTS, &reserved);
+
+  TEST_ASSERT_EQUAL(0xAA, storage[LARGE_WORD_SIZE * LARGE_MAX_ELEMENTS - 1]);
+}
+
+void
+test_pushPopLargeRecordsInBufferOfSeveralMegabytes(void)
+{
+  initMultiReaderBuffer((MultiReaderBuffer*) large_buffer, LARGE_WORD_SIZE, LARGE_MAX_ELEMENTS, MAX_READERS);
+  uint8_t reader = getNewBufferReaderDescriptor(large_buffer);
+  LargeRecord record;
+
+  for (uint32_t sequence = 0; sequence < LARGE_MAX_ELEMENTS + 100; sequence++)
+  {
+    fillLargeRecord(&record, sequence);
+    pushToBuffer(large_buffer, &record);
+  }
+
+  TEST_ASSERT_EQUAL(100, getNumberOfLostElementsForReader(large_buffer, reader));
+
+  CEXCEPTION_T e;
+
+  Try
+  {
+    popFromBufferWithReader(large_buffer, reader);
+    TEST_FAIL_MESSAGE("Exception not thrown!");
+  }
+  Catch (e)
+  {
+    TEST_ASSERT_EQUAL_HEX32(BUFFER_OVERRUN_EXCEPTION, e);
+  }
+
+  for (uint32_t sequence = 100; sequence < LARGE_MAX_ELEMENTS + 100; sequence++)
+  {
+    const LargeRecord *read = (const LargeRecord*) popFromBufferWithReader(large_buffer, reader);
+    TEST_ASSERT_EQUAL_UINT32(sequence, read->sequence);
+    TEST_ASSERT_EQUAL_UINT8((uint8_t) sequence, read->payload[sizeof(read->payload) - 1]);
+  }
+}
+
+static void
+initRejectingBuffer(void)
+{
+  initMultiReaderBufferWithOptions(circular_buffer, BUFFER_WORD_SIZE, MAX_ELEMENTS, MAX_READERS, MULTI_READER_BUFFER_REJECT_WHEN_FULL);
+}
+
+void
+test_freeSpaceIsRelativeToSlowestReader(void)
+{
+  uint8_t slow_reader = getNewBufferReaderDescriptor(buffer);
+  uint8_t fast_reader = getNewBufferReaderDescriptor(buffer);
+
+  TEST_ASSERT_EQUAL(MAX_ELEMENTS, getFreeSpaceOfBuffer(buffer));
+
+  uint16_t input = 0;
+  for (; input < 10; input++)
+  {
+    pushToBuffer(buffer, &input);
+  }
+  consumeWithReader(buffer, fast_reader, 10);
+  consumeWithReader(buffer, slow_reader, 3);
+
+  TEST_ASSERT_EQUAL(MAX_ELEMENTS - 7, getFreeSpaceOfBuffer(buffer));
+
+  deleteBufferReaderDescriptor(buffer, slow_reader);
+  TEST_ASSERT_EQUAL(MAX_ELEMENTS, getFreeSpaceOfBuffer(buffer));
+}
+
+void
+test_rejectingBufferReturnsFullInsteadOfOverwriting(void)
+{
+  initRejectingBuffer();
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+
+  uint16_t input = 0;
+  for (; input < MAX_ELEMENTS; input++)
+  {
+    TEST_ASSERT_EQUAL(BUFFER_OK, pushToBuffer(buffer, &input));
+  }
+  TEST_ASSERT_EQUAL(BUFFER_FULL, pushToBuffer(buffer, &input));
+
+  TEST_ASSERT_EQUAL(0, *((const uint16_t*) popFromBufferWithReader(buffer, reader)));
+  TEST_ASSERT_EQUAL(BUFFER_OK, pushToBuffer(buffer, &input));
+  TEST_ASSERT_EQUAL(0, getNumberOfLostElementsForReader(buffer, reader));
+}
+
+void
+test_rejectingBufferRejectsWholeBurstThatDoesNotFit(void)
+{
+  initRejectingBuffer();
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+  uint16_t burst[MAX_ELEMENTS] = {0};
+
+  TEST_ASSERT_EQUAL(BUFFER_OK, pushManyToBuffer(buffer, burst, MAX_ELEMENTS - 2));
+  TEST_ASSERT_EQUAL(BUFFER_FULL, pushManyToBuffer(buffer, burst, 3));
+  TEST_ASSERT_EQUAL(BUFFER_OK, pushManyToBuffer(buffer, burst, 2));
+
+  BufferSpan span;
+  TEST_ASSERT_EQUAL(MAX_ELEMENTS, peekSpanWithReader(buffer, reader, &span));
+}
+
+void
+test_rejectingBufferReservesAtMostFreeSpace(void)
+{
+  initRejectingBuffer();
+  getNewBufferReaderDescriptor(buffer);
+
+  size_t reserved = 0;
+  reserveBufferSpace(buffer, 10, &reserved);
+  commitBufferSpace(buffer, 10);
+
+  reserveBufferSpace(buffer, MAX_ELEMENTS, &reserved);
+  TEST_ASSERT_EQUAL(MAX_ELEMENTS - 10, reserved);
+}
+
+void
+test_rejectingBufferWithoutReadersKeepsOverwriting(void)
+{
+  initRejectingBuffer();
+
+  uint16_t input = 0;
+  for (; input < 2 * MAX_ELEMENTS; input++)
+  {
+    TEST_ASSERT_EQUAL(BUFFER_OK, pushToBuffer(buffer, &input));
+  }
+}
+
+#define MANY_READERS (20)
+
+static uint8_t raw_memory_many_readers_buffer[MULTI_READER_BUFFER_SIZE(BUFFER_WORD_SIZE, MAX_ELEMENTS, MANY_READERS)];
+static Buffer *many_readers_buffer = (Buffer*) &raw_memory_many_readers_buffer;
+
+void
+test_onlyLaggingReaderAmongManyIsOverrun(void)
+{
+  initMultiReaderBuffer((MultiReaderBuffer*) many_readers_buffer, BUFFER_WORD_SIZE, MAX_ELEMENTS, MANY_READERS);
+
+  for (uint8_t reader = 0; reader < MANY_READERS; reader++)
+  {
+    getNewBufferReaderDescriptor(many_readers_buffer);
+  }
+  deleteBufferReaderDescriptor(many_readers_buffer, 3);
+
+  uint16_t input = 0;
+  for (; input < 3 * MAX_ELEMENTS; input++)
+  {
+    pushToBuffer(many_readers_buffer, &input);
+
+    for (uint8_t reader = 0; reader < MANY_READERS; reader++)
+    {
+      if (reader != 3 && reader != 17)
+      {
+        popFromBufferWithReader(many_readers_buffer, reader);
+      }
+    }
+  }
+
+  TEST_ASSERT_EQUAL(0, getNumberOfLostElementsForReader(many_readers_buffer, 16));
+  TEST_ASSERT_EQUAL(2 * MAX_ELEMENTS, getNumberOfLostElementsForReader(many_readers_buffer, 17));
+  TEST_ASSERT_EQUAL(0, getFreeSpaceOfBuffer(many_readers_buffer));
+
+  deleteBufferReaderDescriptor(many_readers_buffer, 17);
+  TEST_ASSERT_EQUAL(MAX_ELEMENTS, getFreeSpaceOfBuffer(many_readers_buffer));
+}
+
+void
+test_tryPopReportsEmptyBufferAndInvalidReader(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+  const void *item = NULL;
+
+  TEST_ASSERT_EQUAL(BUFFER_EMPTY, tryPopFromBufferWithReader(buffer, reader, &item));
+  TEST_ASSERT_EQUAL(BUFFER_INVALID_READER, tryPopFromBufferWithReader(buffer, reader + 1, &item));
+  TEST_ASSERT_EQUAL(BUFFER_INVALID_READER, tryPeekAtBufferWithReader(buffer, MAX_READERS, &item));
+  TEST_ASSERT_NULL(item);
+}
+
+void
+test_tryPeekAndTryPop(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+  uint16_t input[2] = {7, 8};
+  const void *item = NULL;
+
+  pushManyToBuffer(buffer, input, 2);
+
+  TEST_ASSERT_EQUAL(BUFFER_OK, tryPeekAtBufferWithReader(buffer, reader, &item));
+  TEST_ASSERT_EQUAL(7, *((const uint16_t*) item));
+  TEST_ASSERT_EQUAL(BUFFER_OK, tryPopFromBufferWithReader(buffer, reader, &item));
+  TEST_ASSERT_EQUAL(7, *((const uint16_t*) item));
+  TEST_ASSERT_EQUAL(BUFFER_OK, tryPopFromBufferWithReader(buffer, reader, &item));
+  TEST_ASSERT_EQUAL(8, *((const uint16_t*) item));
+  TEST_ASSERT_EQUAL(BUFFER_EMPTY, tryPeekAtBufferWithReader(buffer, reader, &item));
+}
+
+void
+test_tryPopReportsOverrunAndContinuesWithOldestElement(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+  const void *item = NULL;
+
+  uint16_t input = 0;
+  for (; input < MAX_ELEMENTS + 2; input++)
+  {
+    pushToBuffer(buffer, &input);
+  }
+
+  TEST_ASSERT_EQUAL(BUFFER_OVERRUN, tryPopFromBufferWithReader(buffer, reader, &item));
+  TEST_ASSERT_EQUAL(BUFFER_OK, tryPopFromBufferWithReader(buffer, reader, &item));
+  TEST_ASSERT_EQUAL(2, *((const uint16_t*) item));
+}
+
+static uint8_t raw_memory_relocated_buffer[MULTI_READER_BUFFER_SIZE(BUFFER_WORD_SIZE, MAX_ELEMENTS, MAX_READERS)];
+
+void
+test_bufferKeepsWorkingWhenMovedToAnotherAddress(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+
+  uint16_t input = 0;
+  for (; input < MAX_ELEMENTS + 5; input++)
+  {
+    pushToBuffer(buffer, &input);
+  }
+
+  memcpy(raw_memory_relocated_buffer, raw_memory_circular_buffer, sizeof(raw_memory_circular_buffer));
+  memset(raw_memory_circular_buffer, 0, sizeof(raw_memory_circular_buffer));
+  Buffer *relocated_buffer = (Buffer*) raw_memory_relocated_buffer;
+
+  BufferSpan span;
+  TEST_ASSERT_EQUAL(BUFFER_OVERRUN, tryPeekAtBufferWithReader(relocated_buffer, reader, &span.first));
+  TEST_ASSERT_EQUAL(MAX_ELEMENTS, peekSpanWithReader(relocated_buffer, reader, &span));
+  TEST_ASSERT_EQUAL(5, ((const uint16_t*) span.first)[0]);
+  TEST_ASSERT_EQUAL(MAX_ELEMENTS + 4, ((const uint16_t*) span.second)[span.second_length - 1]);
+}
+
+static size_t notification_count;
+
+static void
+countNotification(void *argument)
+{
+  (*(size_t*) argument)++;
+}
+
+void
+test_notificationFiresWhenThresholdIsReached(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+  GenericCallback callback = {countNotification, &notification_count};
+  uint16_t input = 0;
+
+  notification_count = 0;
+  setBufferReaderNotification(buffer, reader, callback, 3);
+
+  pushToBuffer(buffer, &input);
+  pushToBuffer(buffer, &input);
+  TEST_ASSERT_EQUAL(0, notification_count);
+
+  pushToBuffer(buffer, &input);
+  TEST_ASSERT_EQUAL(1, notification_count);
+}
+
+void
+test_notificationIsCoalescedUntilReaderReads(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+  GenericCallback callback = {countNotification, &notification_count};
+  uint16_t input[10] = {0};
+
+  notification_count = 0;
+  setBufferReaderNotification(buffer, reader, callback, 1);
+
+  for (size_t index = 0; index < 10; index++)
+  {
+    pushToBuffer(buffer, &input[index]);
+  }
+  pushManyToBuffer(buffer, input, 10);
+  TEST_ASSERT_EQUAL(1, notification_count);
+
+  popFromBufferWithReader(buffer, reader);
+  pushToBuffer(buffer, &input[0]);
+  TEST_ASSERT_EQUAL(2, notification_count);
+}
+
+void
+test_notificationFiresOncePerBurst(void)
+{
+  uint8_t first_reader = getNewBufferReaderDescriptor(buffer);
+  uint8_t second_reader = getNewBufferReaderDescriptor(buffer);
+  GenericCallback callback = {countNotification, &notification_count};
+  uint16_t input[10] = {0};
+
+  notification_count = 0;
+  setBufferReaderNotification(buffer, first_reader, callback, 5);
+  setBufferReaderNotification(buffer, second_reader, callback, 20);
+
+  pushManyToBuffer(buffer, input, 10);
+  TEST_ASSERT_EQUAL(1, notification_count);
+}
+
+void
+test_notificationIsRemovedWithThresholdZeroAndWithDescriptor(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+  GenericCallback callback = {countNotification, &notification_count};
+  uint16_t input = 0;
+
+  notification_count = 0;
+  setBufferReaderNotification(buffer, reader, callback, 1);
+  setBufferReaderNotification(buffer, reader, callback, 0);
+  pushToBuffer(buffer, &input);
+
+  setBufferReaderNotification(buffer, reader, callback, 1);
+  deleteBufferReaderDescriptor(buffer, reader);
+  reader = getNewBufferReaderDescriptor(buffer);
+  pushToBuffer(buffer, &input);
+
+  TEST_ASSERT_EQUAL(0, notification_count);
+}
+
+void
+test_setNotificationWithInvalidReaderThrowsException(void)
+{
+  GenericCallback callback = {countNotification, &notification_count};
+  CEXCEPTION_T e;
+
+  Try
+  {
+    setBufferReaderNotification(buffer, 0, callback, 1);
+    TEST_FAIL_MESSAGE("Exception not thrown!");
+  }
+  Catch (e)
+  {
+    TEST_ASSERT_EQUAL_HEX32(BUFFER_INVALID_READER_EXCEPTION, e);
+  }
+}
+
+static void
+pushValuesUpTo(Buffer *target, uint16_t count)
+{
+  for (uint16_t input = 0; input < count; input++)
+  {
+    pushToBuffer(target, &input);
+  }
+}
+
+void
+test_sequenceNumbersCountPushedItems(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+  uint16_t input[3] = {0};
+
+  TEST_ASSERT_EQUAL_UINT64(0, getNextBufferSequenceNumber(buffer));
+  pushToBuffer(buffer, input);
+  pushManyToBuffer(buffer, input, 3);
+  TEST_ASSERT_EQUAL_UINT64(4, getNextBufferSequenceNumber(buffer));
+
+  popFromBufferWithReader(buffer, reader);
+  TEST_ASSERT_EQUAL_UINT64(1, getBufferReaderSequenceNumber(buffer, reader));
+}
+
+static void
+checkOverrunReaderReportsFirstLostItem(Buffer *target, uint16_t max_elements)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(target);
+  const void *item = NULL;
+
+  pushValuesUpTo(target, max_elements + 10);
+  TEST_ASSERT_EQUAL_UINT64(0, getBufferReaderSequenceNumber(target, reader));
+
+  TEST_ASSERT_EQUAL(BUFFER_OVERRUN, tryPopFromBufferWithReader(target, reader, &item));
+  TEST_ASSERT_EQUAL_UINT64(10, getBufferReaderSequenceNumber(target, reader));
+}
+
+void
+test_overrunReaderReportsSequenceNumberOfFirstLostItem(void)
+{
+  checkOverrunReaderReportsFirstLostItem(buffer, MAX_ELEMENTS);
+}
+
+void
+test_overrunPowerOfTwoReaderReportsSequenceNumberOfFirstLostItem(void)
+{
+  initPowerOfTwoBuffer();
+  checkOverrunReaderReportsFirstLostItem(power_of_two_buffer, POWER_OF_TWO_MAX_ELEMENTS);
+}
+
+void
+test_seekToSequenceNumberResumesAfterAcknowledgedItem(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+
+  pushValuesUpTo(buffer, MAX_ELEMENTS + 10);  // Items 0 to 9 have been evicted
+
+  TEST_ASSERT_EQUAL(BUFFER_OK, seekBufferReaderToSequenceNumber(buffer, reader, 25));
+  TEST_ASSERT_EQUAL(25, *((const uint16_t*) popFromBufferWithReader(buffer, reader)));
+  TEST_ASSERT_EQUAL_UINT64(26, getBufferReaderSequenceNumber(buffer, reader));
+
+  TEST_ASSERT_EQUAL(BUFFER_OK, seekBufferReaderToSequenceNumber(buffer, reader, 10));
+  TEST_ASSERT_EQUAL(10, *((const uint16_t*) popFromBufferWithReader(buffer, reader)));
+}
+
+void
+test_seekToEvictedOrFutureSequenceNumberDoesNotMoveReader(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+
+  const void *item = NULL;
+
+  pushValuesUpTo(buffer, MAX_ELEMENTS + 10);
+  TEST_ASSERT_EQUAL(BUFFER_OVERRUN, tryPopFromBufferWithReader(buffer, reader, &item));
+
+  TEST_ASSERT_EQUAL(BUFFER_EVICTED, seekBufferReaderToSequenceNumber(buffer, reader, 9));
+  TEST_ASSERT_EQUAL(BUFFER_EMPTY, seekBufferReaderToSequenceNumber(buffer, reader, MAX_ELEMENTS + 11));
+  TEST_ASSERT_EQUAL(BUFFER_INVALID_READER, seekBufferReaderToSequenceNumber(buffer, reader + 1, 20));
+  TEST_ASSERT_EQUAL_UINT64(10, getBufferReaderSequenceNumber(buffer, reader));
+}
+
+void
+test_seekToOldestAndNewest(void)
+{
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+
+  TEST_ASSERT_EQUAL_UINT64(0, seekBufferReaderToNewest(buffer, reader));
+  pushValuesUpTo(buffer, MAX_ELEMENTS + 10);
+
+  TEST_ASSERT_EQUAL_UINT64(MAX_ELEMENTS + 9, seekBufferReaderToNewest(buffer, reader));
+  TEST_ASSERT_EQUAL(MAX_ELEMENTS + 9, *((const uint16_t*) popFromBufferWithReader(buffer, reader)));
+  TEST_ASSERT_FALSE(readableItemExistsForReader(buffer, reader));
+
+  TEST_ASSERT_EQUAL_UINT64(10, seekBufferReaderToOldest(buffer, reader));
+  TEST_ASSERT_EQUAL(10, *((const uint16_t*) popFromBufferWithReader(buffer, reader)));
+}
+
+void
+test_seekClearsPendingOverrunOfLappedPowerOfTwoReader(void)
+{
+  initPowerOfTwoBuffer();
+  uint8_t reader = getNewBufferReaderDescriptor(power_of_two_buffer);
+
+  pushValuesUpTo(power_of_two_buffer, 3 * POWER_OF_TWO_MAX_ELEMENTS);
+
+  TEST_ASSERT_EQUAL_UINT64(0, getBufferReaderSequenceNumber(power_of_two_buffer, reader));
+  TEST_ASSERT_EQUAL(BUFFER_EVICTED, seekBufferReaderToSequenceNumber(power_of_two_buffer, reader, 2 * POWER_OF_TWO_MAX_ELEMENTS - 1));
+  TEST_ASSERT_EQUAL(BUFFER_OK, seekBufferReaderToSequenceNumber(power_of_two_buffer, reader, 2 * POWER_OF_TWO_MAX_ELEMENTS + 3));
+  TEST_ASSERT_EQUAL(2 * POWER_OF_TWO_MAX_ELEMENTS + 3, *((const uint16_t*) popFromBufferWithReader(power_of_two_buffer, reader)));
+}
+
+void
+test_seekBackwardsKeepsRejectingBufferFromOverwriting(void)
+{
+  initMultiReaderBufferWithOptions(circular_buffer, BUFFER_WORD_SIZE, MAX_ELEMENTS, MAX_READERS, MULTI_READER_BUFFER_REJECT_WHEN_FULL);
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+  uint16_t input = 0;
+
+  pushValuesUpTo(buffer, MAX_ELEMENTS);
+  consumeWithReader(buffer, reader, MAX_ELEMENTS);
+  pushToBuffer(buffer, &input);
+
+  TEST_ASSERT_EQUAL(BUFFER_OK, seekBufferReaderToSequenceNumber(buffer, reader, 1));
+  TEST_ASSERT_EQUAL(BUFFER_FULL, pushToBuffer(buffer, &input));
+}
+
+typedef struct SpilledItems
+{
+  uint16_t items[3 * MAX_ELEMENTS];
+  size_t count;
+  size_t calls;
+} SpilledItems;
+
+static void
+collectSpilledItems(void *argument, const void *items, size_t count)
+{
+  SpilledItems *spilled = (SpilledItems*) argument;
+
+  memcpy(spilled->items + spilled->count, items, count * sizeof(uint16_t));
+  spilled->count += count;
+  spilled->calls++;
+}
+
+void
+test_durableReaderGetsItemsViaSpillHandlerInsteadOfOverrun(void)
+{
+  uint8_t durable_reader = getNewBufferReaderDescriptor(buffer);
+  uint8_t other_reader = getNewBufferReaderDescriptor(buffer);
+  SpilledItems spilled = {{0}, 0, 0};
+  BufferSpillHandler handler = {collectSpilledItems, &spilled};
+  uint16_t input[2 * MAX_ELEMENTS + 5];
+
+  setBufferSpillHandler(buffer, durable_reader, handler, 1);
+  pushValuesUpTo(buffer, MAX_ELEMENTS + 10);
+  for (uint16_t index = 0; index < 2 * MAX_ELEMENTS + 5; index++)
+  {
+    input[index] = MAX_ELEMENTS + 10 + index;
+  }
+  pushManyToBuffer(buffer, input, 2 * MAX_ELEMENTS + 5);
+
+  /* The spilled items followed by the held ones are all items in order */
+
+  TEST_ASSERT_EQUAL(2 * MAX_ELEMENTS + 15, spilled.count);
+  for (uint16_t index = 0; index < spilled.count; index++)
+  {
+    TEST_ASSERT_EQUAL(index, spilled.items[index]);
+  }
+  for (uint16_t index = spilled.count; index < 3 * MAX_ELEMENTS + 15; index++)
+  {
+    TEST_ASSERT_EQUAL(index, *((const uint16_t*) popFromBufferWithReader(buffer, durable_reader)));
+  }
+
+  const void *item;
+  TEST_ASSERT_EQUAL(BUFFER_OVERRUN, tryPopFromBufferWithReader(buffer, other_reader, &item));
+}
+
+void
+test_spillHandlerIsCalledWithBatchesAndRemovedWithReader(void)
+{
+  uint8_t durable_reader = getNewBufferReaderDescriptor(buffer);
+  SpilledItems spilled = {{0}, 0, 0};
+  BufferSpillHandler handler = {collectSpilledItems, &spilled};
+
+  setBufferSpillHandler(buffer, durable_reader, handler, 10);
+  pushValuesUpTo(buffer, MAX_ELEMENTS + 20);
+
+  TEST_ASSERT_EQUAL(20, spilled.count);
+  TEST_ASSERT_EQUAL(2, spilled.calls);
+  TEST_ASSERT_EQUAL_UINT64(20, getBufferReaderSequenceNumber(buffer, durable_reader));
+
+  deleteBufferReaderDescriptor(buffer, durable_reader);
+  durable_reader = getNewBufferReaderDescriptor(buffer);
+  pushValuesUpTo(buffer, MAX_ELEMENTS);
+  TEST_ASSERT_EQUAL(20, spilled.count);
+}
+
+void
+test_spillHandlerHandsOverWrappedItemsOfPowerOfTwoBuffer(void)
+{
+  initPowerOfTwoBuffer();
+  uint8_t durable_reader = getNewBufferReaderDescriptor(power_of_two_buffer);
+  SpilledItems spilled = {{0}, 0, 0};
+  BufferSpillHandler handler = {collectSpilledItems, &spilled};
+
+  pushValuesUpTo(power_of_two_buffer, 10);
+  consumeWithReader(power_of_two_buffer, durable_reader, 10);
+  setBufferSpillHandler(power_of_two_buffer, durable_reader, handler, POWER_OF_TWO_MAX_ELEMENTS);
+  pushValuesUpTo(power_of_two_buffer, POWER_OF_TWO_MAX_ELEMENTS + 1);
+
+  TEST_ASSERT_EQUAL(POWER_OF_TWO_MAX_ELEMENTS, spilled.count);
+  TEST_ASSERT_EQUAL(2, spilled.calls);  // Split at the end of the memory
+  for (uint16_t index = 0; index < POWER_OF_TWO_MAX_ELEMENTS; index++)
+  {
+    TEST_ASSERT_EQUAL(index, spilled.items[index]);
+  }
+  TEST_ASSERT_EQUAL(POWER_OF_TWO_MAX_ELEMENTS, *((const uint16_t*) popFromBufferWithReader(power_of_two_buffer, durable_reader)));
+}
@@ -0,0 +1,270 @@
+#include <unity.h>
+#include <CException.h>
+#include <string.h>
+#include "EmbeddedUtilities/MultiReaderRecordBuffer.h"
+
+#define MAX_BYTES (64)
+#define MAX_READERS (3)
+
+static uint8_t raw_memory[MULTI_READER_RECORD_BUFFER_SIZE(MAX_BYTES, MAX_READERS)];
+static MultiReaderRecordBuffer *buffer = (MultiReaderRecordBuffer*) &raw_memory;
+
+static void
+pushRecordOfLength(size_t length, uint8_t fill)
+{
+  uint8_t record[MAX_BYTES];
+  memset(record, fill, length);
+  pushRecord(buffer, record, length);
+}
+
+static void
+checkRecordContent(const void *record, size_t length, uint8_t expected_fill)
+{
+  for (size_t index = 0; index < length; index++)
+  {
+    TEST_ASSERT_EQUAL_HEX8(expected_fill, ((const uint8_t*) record)[index]);
+  }
+}
+
+static void
+popAndCheckRecord(uint8_t reader, size_t expected_length, uint8_t expected_fill)
+{
+  size_t length;
+  const void *record = popRecordWithReader(buffer, reader, &length);
+
+  TEST_ASSERT_EQUAL(expected_length, length);
+  checkRecordContent(record, length, expected_fill);
+}
+
+void
+setUp(void)
+{
+  initMultiReaderRecordBuffer(buffer, MAX_BYTES, MAX_READERS);
+}
+
+void
+test_initWithCapacityThatIsNoPowerOfTwoThrows(void)
+{
+  CEXCEPTION_T e;
+
+  Try
+  {
+    initMultiReaderRecordBuffer(buffer, 48, MAX_READERS);
+    TEST_FAIL_MESSAGE("Exception not thrown!");
+  }
+  Catch (e)
+  {
+    TEST_ASSERT_EQUAL(BUFFER_INVALID_CAPACITY_EXCEPTION, e);
+  }
+}
+
+void
+test_popRecordsOfDifferentLengthInOrder(void)
+{
+  uint8_t reader = getNewRecordBufferReaderDescriptor(buffer);
+
+  pushRecordOfLength(1, 0x11);
+  pushRecordOfLength(7, 0x22);
+  pushRecordOfLength(0, 0x33);
+  pushRecordOfLength(20, 0x44);
+
+  popAndCheckRecord(reader, 1, 0x11);
+  popAndCheckRecord(reader, 7, 0x22);
+  popAndCheckRecord(reader, 0, 0x33);
+  popAndCheckRecord(reader, 20, 0x44);
+  TEST_ASSERT_FALSE(readableRecordExistsForReader(buffer, reader));
+}
+
+void
+test_peekDoesNotAdvanceReader(void)
+{
+  uint8_t reader = getNewRecordBufferReaderDescriptor(buffer);
+  size_t length;
+
+  pushRecordOfLength(5, 0xAB);
+  peekRecordWithReader(buffer, reader, &length);
+
+  TEST_ASSERT_EQUAL(5, length);
+  popAndCheckRecord(reader, 5, 0xAB);
+}
+
+void
+test_popFromEmptyBufferThrowsUnderrun(void)
+{
+  uint8_t reader = getNewRecordBufferReaderDescriptor(buffer);
+  CEXCEPTION_T e;
+  size_t length;
+
+  Try
+  {
+    popRecordWithReader(buffer, reader, &length);
+    TEST_FAIL_MESSAGE("Exception not thrown!");
+  }
+  Catch (e)
+  {
+    TEST_ASSERT_EQUAL(BUFFER_UNDERRUN_EXCEPTION, e);
+  }
+}
+
+void
+test_pushRecordLongerThanHalfTheCapacityThrows(void)
+{
+  CEXCEPTION_T e;
+
+  pushRecordOfLength(MULTI_READER_RECORD_BUFFER_MAX_RECORD_LENGTH(MAX_BYTES), 0x01);
+
+  Try
+  {
+    pushRecordOfLength(MULTI_READER_RECORD_BUFFER_MAX_RECORD_LENGTH(MAX_BYTES) + 1, 0x02);
+    TEST_FAIL_MESSAGE("Exception not thrown!");
+  }
+  Catch (e)
+  {
+    TEST_ASSERT_EQUAL(BUFFER_INVALID_RECORD_LENGTH_EXCEPTION, e);
+  }
+}
+
+void
+test_recordThatDoesNotFitBeforeTheEndIsStoredContiguouslyAtTheStart(void)
+{
+  uint8_t reader = getNewRecordBufferReaderDescriptor(buffer);
+
+  pushRecordOfLength(20, 0x11);  // Occupies bytes 0 to 21
+  pushRecordOfLength(20, 0x22);  // Occupies bytes 22 to 43
+  popAndCheckRecord(reader, 20, 0x11);
+  popAndCheckRecord(reader, 20, 0x22);
+
+  pushRecordOfLength(20, 0x33);  // Does not fit into the remaining 20 bytes, so it wraps
+
+  size_t length;
+  const uint8_t *record = popRecordWithReader(buffer, reader, &length);
+  const uint8_t *storage = (const uint8_t*) ((const RecordBufferReader*) (buffer + 1) + MAX_READERS);
+
+  TEST_ASSERT_EQUAL(20, length);
+  TEST_ASSERT_EQUAL_PTR(storage + MULTI_READER_RECORD_BUFFER_HEADER_SIZE, record);
+  checkRecordContent(record, 20, 0x33);
+}
+
+void
+test_wrapWithLessSpaceLeftThanAHeader(void)
+{
+  uint8_t reader = getNewRecordBufferReaderDescriptor(buffer);
+
+  pushRecordOfLength(29, 0x11);  // Occupies bytes 0 to 30
+  pushRecordOfLength(30, 0x22);  // Occupies bytes 31 to 62, a single byte is left
+  popAndCheckRecord(reader, 29, 0x11);
+  popAndCheckRecord(reader, 30, 0x22);
+
+  pushRecordOfLength(3, 0x33);
+  popAndCheckRecord(reader, 3, 0x33);
+  TEST_ASSERT_FALSE(readableRecordExistsForReader(buffer, reader));
+}
+
+void
+test_readersProceedIndependently(void)
+{
+  uint8_t fast_reader = getNewRecordBufferReaderDescriptor(buffer);
+  uint8_t slow_reader = getNewRecordBufferReaderDescriptor(buffer);
+
+  pushRecordOfLength(3, 0x11);
+  pushRecordOfLength(4, 0x22);
+
+  popAndCheckRecord(fast_reader, 3, 0x11);
+  popAndCheckRecord(fast_reader, 4, 0x22);
+  popAndCheckRecord(slow_reader, 3, 0x11);
+
+  TEST_ASSERT_FALSE(readableRecordExistsForReader(buffer, fast_reader));
+  TEST_ASSERT_TRUE(readableRecordExistsForReader(buffer, slow_reader));
+}
+
+void
+test_overrunReaderLosesOverwrittenRecordsAndContinuesWithOldest(void)
+{
+  uint8_t reader = getNewRecordBufferReaderDescriptor(buffer);
+  CEXCEPTION_T e;
+  size_t length;
+
+  for (uint8_t record = 0; record < 10; record++)
+  {
+    pushRecordOfLength(6, record);  // 8 bytes each, so only the latest 8 records fit
+  }
+
+  Try
+  {
+    popRecordWithReader(buffer, reader, &length);
+    TEST_FAIL_MESSAGE("Exception not thrown!");
+  }
+  Catch (e)
+  {
+    TEST_ASSERT_EQUAL(BUFFER_OVERRUN_EXCEPTION, e);
+  }
+
+  TEST_ASSERT_EQUAL(2, getNumberOfLostRecordsForReader(buffer, reader));
+
+  for (uint8_t record = 2; record < 10; record++)
+  {
+    popAndCheckRecord(reader, 6, record);
+  }
+}
+
+void
+test_newReaderStartsAtOldestRecord(void)
+{
+  for (uint8_t record = 0; record < 10; record++)
+  {
+    pushRecordOfLength(6, record);
+  }
+
+  uint8_t reader = getNewRecordBufferReaderDescriptor(buffer);
+  popAndCheckRecord(reader, 6, 2);
+}
+
+void
+test_tryPopReportsStatusInsteadOfThrowing(void)
+{
+  uint8_t reader = getNewRecordBufferReaderDescriptor(buffer);
+  const void *record;
+  size_t length;
+
+  TEST_ASSERT_EQUAL(BUFFER_EMPTY, tryPopRecordWithReader(buffer, reader, &record, &length));
+  TEST_ASSERT_EQUAL(BUFFER_INVALID_READER, tryPopRecordWithReader(buffer, reader + 1, &record, &length));
+
+  for (uint8_t value = 0; value < 10; value++)
+  {
+    pushRecordOfLength(6, value);
+  }
+
+  TEST_ASSERT_EQUAL(BUFFER_OVERRUN, tryPopRecordWithReader(buffer, reader, &record, &length));
+  TEST_ASSERT_EQUAL(BUFFER_OK, tryPopRecordWithReader(buffer, reader, &record, &length));
+  TEST_ASSERT_EQUAL(6, length);
+  checkRecordContent(record, 6, 2);
+}
+
+void
+test_manySmallRecordsAreStoredWithoutPadding(void)
+{
+  uint8_t reader = getNewRecordBufferReaderDescriptor(buffer);
+
+  for (uint8_t record = 0; record < MAX_BYTES / 3; record++)
+  {
+    pushRecordOfLength(1, record);  // 3 bytes each
+  }
+
+  for (uint8_t record = 0; record < MAX_BYTES / 3; record++)
+  {
+    popAndCheckRecord(reader, 1, record);
+  }
+}
+
+void
+test_recordsSurviveManyWrapArounds(void)
+{
+  uint8_t reader = getNewRecordBufferReaderDescriptor(buffer);
+
+  for (size_t round = 0; round < 1000; round++)
+  {
+    size_t length = round % (MULTI_READER_RECORD_BUFFER_MAX_RECORD_LENGTH(MAX_BYTES) + 1);
+    pushRecordOfLength(length, round);
+    popAndCheckRecord(reader, length, round);
+  }
+}
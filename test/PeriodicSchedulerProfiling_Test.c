@@ -0,0 +1,146 @@
+#include "EmbeddedUtilities/Debug.h"
+#include "EmbeddedUtilities/PeriodicScheduler.h"
+#include <CException.h>
+#include <unity.h>
+
+/*
+ * Needs the scheduler built with -DPERIODIC_SCHEDULER_PROFILING=1,
+ * see the PeriodicSchedulerProfiling target.
+ */
+
+#define PERIODIC_SCHEDULER_MAX_NUMBER_OF_TASKS (4)
+
+static uint8_t memory[PERIODIC_SCHEDULER_SIZE(PERIODIC_SCHEDULER_MAX_NUMBER_OF_TASKS)];
+static PeriodicScheduler *scheduler = (PeriodicScheduler *)memory;
+static uint32_t fake_time;
+static uint32_t execution_times[] = {5, 9, 7};
+static uint8_t number_of_calls;
+static Ticks ticks_passing_during_execution;
+
+static uint32_t
+readFakeTime(void)
+{
+  return fake_time;
+}
+
+void
+takeSomeTime(void *argument)
+{
+  fake_time += execution_times[number_of_calls % 3];
+  updateScheduledTasks(scheduler, ticks_passing_during_execution);
+  number_of_calls++;
+}
+
+static uint8_t
+addTask(Ticks period)
+{
+  Task task = {
+    .function = takeSomeTime,
+    .period   = period,
+  };
+  return addTaskToScheduler(scheduler, &task);
+}
+
+static void
+runFor(Ticks number_of_ticks)
+{
+  updateScheduledTasks(scheduler, number_of_ticks);
+  processScheduledTasks(scheduler);
+}
+
+void
+setUp(void)
+{
+  scheduler =
+    createPeriodicScheduler(memory, PERIODIC_SCHEDULER_MAX_NUMBER_OF_TASKS);
+  setSchedulerTimestampSource(scheduler, readFakeTime);
+  fake_time = 1000;
+  number_of_calls = 0;
+  ticks_passing_during_execution = 0;
+}
+
+void
+test_profileIsEmptyBeforeFirstExecution(void)
+{
+  TaskProfile profile;
+  uint8_t id = addTask(10);
+  getTaskProfile(scheduler, id, &profile);
+  TEST_ASSERT_EQUAL_UINT32(0, profile.number_of_executions);
+  TEST_ASSERT_EQUAL_UINT32(0, profile.min_execution_time);
+  TEST_ASSERT_EQUAL_UINT32(0, profile.mean_execution_time);
+}
+
+void
+test_profileRecordsExecutionTimes(void)
+{
+  TaskProfile profile;
+  uint8_t id = addTask(1);
+  runFor(1);
+  runFor(1);
+  runFor(1);
+  getTaskProfile(scheduler, id, &profile);
+  TEST_ASSERT_EQUAL_UINT32(3, profile.number_of_executions);
+  TEST_ASSERT_EQUAL_UINT32(5, profile.min_execution_time);
+  TEST_ASSERT_EQUAL_UINT32(9, profile.max_execution_time);
+  TEST_ASSERT_EQUAL_UINT32(7, profile.mean_execution_time);
+}
+
+void
+test_profileRecordsReleaseJitterInTicks(void)
+{
+  TaskProfile profile;
+  uint8_t id = addTask(10);
+  runFor(13);
+  runFor(10);
+  getTaskProfile(scheduler, id, &profile);
+  TEST_ASSERT_EQUAL_UINT32(2, profile.number_of_executions);
+  TEST_ASSERT_EQUAL_UINT32(3, profile.max_release_jitter);
+  TEST_ASSERT_EQUAL_UINT32(1, profile.mean_release_jitter);
+  TEST_ASSERT_EQUAL_UINT32(0, profile.number_of_overruns);
+}
+
+void
+test_profileCountsInstancesCompletingAfterTheNextBecameDue(void)
+{
+  TaskProfile profile;
+  uint8_t id = addTask(10);
+  ticks_passing_during_execution = 9;
+  runFor(10);
+  ticks_passing_during_execution = 12;
+  runFor(1);
+  getTaskProfile(scheduler, id, &profile);
+  TEST_ASSERT_EQUAL_UINT32(2, profile.number_of_executions);
+  TEST_ASSERT_EQUAL_UINT32(1, profile.number_of_overruns);
+}
+
+void
+test_profilesAreKeptPerTask(void)
+{
+  TaskProfile profile;
+  uint8_t first_id = addTask(2);
+  uint8_t second_id = addTask(3);
+  for (uint8_t tick = 0; tick < 6; tick++)
+    {
+      runFor(1);
+    }
+  getTaskProfile(scheduler, first_id, &profile);
+  TEST_ASSERT_EQUAL_UINT32(3, profile.number_of_executions);
+  getTaskProfile(scheduler, second_id, &profile);
+  TEST_ASSERT_EQUAL_UINT32(2, profile.number_of_executions);
+}
+
+void
+test_profileOfInvalidTaskThrows(void)
+{
+  TaskProfile profile;
+  CEXCEPTION_T exception;
+  Try
+  {
+    getTaskProfile(scheduler, 1, &profile);
+    TEST_FAIL();
+  }
+  Catch(exception)
+  {
+    TEST_ASSERT_EQUAL(PERIODIC_SCHEDULER_INVALID_TASK_EXCEPTION, exception);
+  }
+}
@@ -420,3 +420,326 @@ test_getNonExistentItemThrowsException(void)
     TEST_ASSERT_EQUAL(PERIODIC_SCHEDULER_INVALID_TASK_EXCEPTION, exception);
   }
 }
+
+void
+test_taskIsDueAfterTickCounterWrappedAround(void)
+{
+  Task task = {
+    .function = someTask,
+    .period   = 60000,
+  };
+  for (uint32_t i = 0; i < 71582; i++)
+    {
+      updateScheduledTasks(scheduler, 60000);
+    }
+  addTaskToScheduler(scheduler, &task);
+  updateScheduledTasks(scheduler, 59999);
+  processScheduledTasks(scheduler);
+  TEST_ASSERT_EQUAL(0, number_of_calls_to_someTask);
+  updateScheduledTasks(scheduler, 1);
+  processScheduledTasks(scheduler);
+  TEST_ASSERT_EQUAL(1, number_of_calls_to_someTask);
+}
+
+void
+test_getTaskByIdReportsTicksElapsedSinceExecution(void)
+{
+  Task task = {
+    .function = someTask,
+    .period   = 10,
+  };
+  uint8_t id = addTaskToScheduler(scheduler, &task);
+  updateScheduledTasks(scheduler, 12);
+  processScheduledTasks(scheduler);
+  updateScheduledTasks(scheduler, 3);
+  TEST_ASSERT_EQUAL_UINT16(3, getScheduledTaskById(scheduler, id)->ticks_elapsed);
+}
+
+void
+test_getTaskByIdReportsTicksElapsedSinceExecutionForPeriodZero(void)
+{
+  Task task = {
+    .function = someTask,
+    .period   = 0,
+  };
+  uint8_t id = addTaskToScheduler(scheduler, &task);
+  processScheduledTasks(scheduler);
+  updateScheduledTasks(scheduler, 3);
+  TEST_ASSERT_EQUAL_UINT16(3, getScheduledTaskById(scheduler, id)->ticks_elapsed);
+}
+
+static uint16_t calls_per_task[PERIODIC_SCHEDULER_MAX_NUMBER_OF_TASKS];
+
+void
+countCallsPerTask(void *argument)
+{
+  calls_per_task[(uintptr_t) argument]++;
+}
+
+void
+test_dispatchMatchesCheckingEverySlot(void)
+{
+  // reference model: every slot ages by the elapsed ticks and is
+  // executed and reset once its elapsed ticks reach the period
+  uint32_t elapsed[PERIODIC_SCHEDULER_MAX_NUMBER_OF_TASKS] = {0};
+  uint16_t expected_calls[PERIODIC_SCHEDULER_MAX_NUMBER_OF_TASKS] = {0};
+  Ticks periods[PERIODIC_SCHEDULER_MAX_NUMBER_OF_TASKS] = {0};
+  bool is_scheduled[PERIODIC_SCHEDULER_MAX_NUMBER_OF_TASKS] = {false};
+  uint32_t random = 12345;
+
+  for (uint8_t i = 0; i < PERIODIC_SCHEDULER_MAX_NUMBER_OF_TASKS; i++)
+    {
+      calls_per_task[i] = 0;
+    }
+  for (uint16_t step = 0; step < 2000; step++)
+    {
+      random = random * 1103515245 + 12345;
+      uint8_t id = (random >> 16) % PERIODIC_SCHEDULER_MAX_NUMBER_OF_TASKS;
+      uint8_t action = (random >> 24) % 8;
+      if (action == 0 && !is_scheduled[id]
+	  && getNumberOfFreeSlotsInSchedule(scheduler) > 0)
+	{
+	  Task task = {
+	    .function = countCallsPerTask,
+	    .period   = 1 + (random >> 8) % 7,
+	  };
+	  uint8_t new_id = addTaskToScheduler(scheduler, &task);
+	  getScheduledTaskById(scheduler, new_id)->argument = (void *) (uintptr_t) new_id;
+	  is_scheduled[new_id] = true;
+	  periods[new_id] = task.period;
+	  elapsed[new_id] = 0;
+	}
+      else if (action == 1 && is_scheduled[id])
+	{
+	  removeScheduledTask(scheduler, id);
+	  is_scheduled[id] = false;
+	}
+      else
+	{
+	  Ticks ticks = (random >> 12) % 4;
+	  updateScheduledTasks(scheduler, ticks);
+	  processScheduledTasks(scheduler);
+	  for (uint8_t i = 0; i < PERIODIC_SCHEDULER_MAX_NUMBER_OF_TASKS; i++)
+	    {
+	      elapsed[i] += ticks;
+	      if (is_scheduled[i] && elapsed[i] >= periods[i])
+		{
+		  expected_calls[i]++;
+		  elapsed[i] = 0;
+		}
+	    }
+	}
+      TEST_ASSERT_EQUAL_UINT16_ARRAY(expected_calls, calls_per_task,
+				     PERIODIC_SCHEDULER_MAX_NUMBER_OF_TASKS);
+    }
+}
+
+static uint8_t self_removing_task_id;
+
+void
+removeItself(void *argument)
+{
+  someTask(argument);
+  removeScheduledTask(scheduler, self_removing_task_id);
+}
+
+void
+test_taskCanRemoveItselfWhileExecuted(void)
+{
+  Task task = {
+    .function = removeItself,
+    .period   = 1,
+  };
+  Task other_task = {
+    .function = someOtherTask,
+    .period   = 1,
+  };
+  self_removing_task_id = addTaskToScheduler(scheduler, &task);
+  addTaskToScheduler(scheduler, &other_task);
+  updateScheduledTasks(scheduler, 1);
+  processScheduledTasks(scheduler);
+  updateScheduledTasks(scheduler, 1);
+  processScheduledTasks(scheduler);
+  TEST_ASSERT_EQUAL(1, number_of_calls_to_someTask);
+  TEST_ASSERT_EQUAL(2, number_of_calls_to_someOtherTask);
+  TEST_ASSERT_EQUAL(PERIODIC_SCHEDULER_MAX_NUMBER_OF_TASKS - 1,
+                    getNumberOfFreeSlotsInSchedule(scheduler));
+}
+
+void
+test_ticksUntilNextDueTask(void)
+{
+  Task task = {
+    .function = someTask,
+    .period   = 10,
+  };
+  Task other_task = {
+    .function = someOtherTask,
+    .period   = 4,
+  };
+  TEST_ASSERT_EQUAL_UINT32(PERIODIC_SCHEDULER_NO_TASK_DUE,
+                           getTicksUntilNextDueTask(scheduler));
+  addTaskToScheduler(scheduler, &task);
+  uint8_t other_id = addTaskToScheduler(scheduler, &other_task);
+  TEST_ASSERT_EQUAL_UINT32(4, getTicksUntilNextDueTask(scheduler));
+  updateScheduledTasks(scheduler, 3);
+  TEST_ASSERT_EQUAL_UINT32(1, getTicksUntilNextDueTask(scheduler));
+  updateScheduledTasks(scheduler, 2);
+  TEST_ASSERT_EQUAL_UINT32(0, getTicksUntilNextDueTask(scheduler));
+  processScheduledTasks(scheduler);
+  TEST_ASSERT_EQUAL_UINT32(4, getTicksUntilNextDueTask(scheduler));
+  removeScheduledTask(scheduler, other_id);
+  TEST_ASSERT_EQUAL_UINT32(5, getTicksUntilNextDueTask(scheduler));
+}
+
+void
+test_withoutCatchUpMissedPeriodsAreExecutedOnce(void)
+{
+  Task task = {
+    .function = someTask,
+    .period   = 10,
+  };
+  addTaskToScheduler(scheduler, &task);
+  updateScheduledTasks(scheduler, 35);
+  processScheduledTasks(scheduler);
+  TEST_ASSERT_EQUAL(1, number_of_calls_to_someTask);
+  TEST_ASSERT_EQUAL_UINT32(10, getTicksUntilNextDueTask(scheduler));
+}
+
+void
+test_catchUpExecutesMissedPeriodsLikeSingleTicks(void)
+{
+  Task tasks[] = {
+    { .function = countCallsPerTask, .period = 3, .argument = (void *) 0 },
+    { .function = countCallsPerTask, .period = 7, .argument = (void *) 1 },
+    { .function = countCallsPerTask, .period = 10, .argument = (void *) 2 },
+  };
+  uint16_t calls_with_single_ticks[3] = {0};
+  calls_per_task[0] = calls_per_task[1] = calls_per_task[2] = 0;
+  for (uint8_t i = 0; i < 3; i++)
+    {
+      addTaskToScheduler(scheduler, tasks + i);
+    }
+  for (uint8_t tick = 0; tick < 100; tick++)
+    {
+      updateScheduledTasks(scheduler, 1);
+      processScheduledTasks(scheduler);
+    }
+  for (uint8_t i = 0; i < 3; i++)
+    {
+      calls_with_single_ticks[i] = calls_per_task[i];
+    }
+
+  scheduler =
+    createPeriodicScheduler(memory, PERIODIC_SCHEDULER_MAX_NUMBER_OF_TASKS);
+  setSchedulerCatchUp(scheduler, true);
+  calls_per_task[0] = calls_per_task[1] = calls_per_task[2] = 0;
+  for (uint8_t i = 0; i < 3; i++)
+    {
+      addTaskToScheduler(scheduler, tasks + i);
+    }
+  updateScheduledTasks(scheduler, 1);
+  processScheduledTasks(scheduler);
+  updateScheduledTasks(scheduler, 98);
+  processScheduledTasks(scheduler);
+  updateScheduledTasks(scheduler, 1);
+  processScheduledTasks(scheduler);
+
+  TEST_ASSERT_EQUAL_UINT16(33, calls_per_task[0]);
+  TEST_ASSERT_EQUAL_UINT16_ARRAY(calls_with_single_ticks, calls_per_task, 3);
+  TEST_ASSERT_EQUAL_UINT32(2, getTicksUntilNextDueTask(scheduler));
+}
+
+static uint8_t
+addTaskWithTiming(TaskTiming timing)
+{
+  Task task = {
+    .function = someTask,
+    .period   = 10,
+  };
+  uint8_t id = addTaskToScheduler(scheduler, &task);
+  setTaskTiming(scheduler, id, timing);
+  return id;
+}
+
+static void
+processEveryThreeTicksUntil(uint16_t last_tick)
+{
+  for (uint16_t tick = 3; tick <= last_tick; tick += 3)
+    {
+      updateScheduledTasks(scheduler, 3);
+      processScheduledTasks(scheduler);
+    }
+}
+
+void
+test_fixedDelayAccumulatesLateness(void)
+{
+  uint8_t id = addTaskWithTiming(PERIODIC_SCHEDULER_FIXED_DELAY);
+  processEveryThreeTicksUntil(300);
+  TEST_ASSERT_EQUAL(25, number_of_calls_to_someTask);
+  TEST_ASSERT_EQUAL_UINT32(0, getNumberOfMissedPeriods(scheduler, id));
+}
+
+void
+test_fixedRateKeepsExactLongTermRate(void)
+{
+  uint8_t id = addTaskWithTiming(PERIODIC_SCHEDULER_FIXED_RATE_COALESCE);
+  processEveryThreeTicksUntil(300);
+  TEST_ASSERT_EQUAL(30, number_of_calls_to_someTask);
+  TEST_ASSERT_EQUAL_UINT32(0, getNumberOfMissedPeriods(scheduler, id));
+}
+
+void
+test_fixedRateRunAllExecutesEveryMissedInstance(void)
+{
+  uint8_t id = addTaskWithTiming(PERIODIC_SCHEDULER_FIXED_RATE_RUN_ALL);
+  updateScheduledTasks(scheduler, 35);
+  processScheduledTasks(scheduler);
+  TEST_ASSERT_EQUAL(3, number_of_calls_to_someTask);
+  TEST_ASSERT_EQUAL_UINT32(2, getNumberOfMissedPeriods(scheduler, id));
+  TEST_ASSERT_EQUAL_UINT32(5, getTicksUntilNextDueTask(scheduler));
+}
+
+void
+test_fixedRateCoalesceExecutesMissedInstancesOnce(void)
+{
+  uint8_t id = addTaskWithTiming(PERIODIC_SCHEDULER_FIXED_RATE_COALESCE);
+  updateScheduledTasks(scheduler, 35);
+  processScheduledTasks(scheduler);
+  TEST_ASSERT_EQUAL(1, number_of_calls_to_someTask);
+  TEST_ASSERT_EQUAL_UINT32(2, getNumberOfMissedPeriods(scheduler, id));
+  TEST_ASSERT_EQUAL_UINT32(5, getTicksUntilNextDueTask(scheduler));
+}
+
+void
+test_fixedRateSkipDropsMissedInstancesUntilNextDeadline(void)
+{
+  uint8_t id = addTaskWithTiming(PERIODIC_SCHEDULER_FIXED_RATE_SKIP);
+  updateScheduledTasks(scheduler, 13);
+  processScheduledTasks(scheduler);
+  TEST_ASSERT_EQUAL(1, number_of_calls_to_someTask);
+  updateScheduledTasks(scheduler, 22);
+  processScheduledTasks(scheduler);
+  TEST_ASSERT_EQUAL(1, number_of_calls_to_someTask);
+  TEST_ASSERT_EQUAL_UINT32(2, getNumberOfMissedPeriods(scheduler, id));
+  TEST_ASSERT_EQUAL_UINT32(5, getTicksUntilNextDueTask(scheduler));
+  updateScheduledTasks(scheduler, 5);
+  processScheduledTasks(scheduler);
+  TEST_ASSERT_EQUAL(2, number_of_calls_to_someTask);
+}
+
+void
+test_timingOfInvalidTaskThrows(void)
+{
+  CEXCEPTION_T exception;
+  Try
+  {
+    setTaskTiming(scheduler, 0, PERIODIC_SCHEDULER_FIXED_RATE_RUN_ALL);
+    TEST_FAIL();
+  }
+  Catch(exception)
+  {
+    TEST_ASSERT_EQUAL(PERIODIC_SCHEDULER_INVALID_TASK_EXCEPTION, exception);
+  }
+}
@@ -0,0 +1,194 @@
+#include <unity.h>
+#include <CException.h>
+#include <sched.h>
+#include <time.h>
+#include "EmbeddedUtilities/PipelineWorkers.h"
+
+/*
+ * The same kind of stage functions as in Pipeline_Test,
+ * run by several worker threads: input -> scale -> scaled -> decimate -> decimated -> sink
+ */
+
+#define CAPACITY (64)
+#define MAX_READERS (1)
+#define NUMBER_OF_ITEMS (20000)
+#define PUSH_BURST (16)
+
+static uint8_t raw_input[MULTI_READER_BUFFER_SIZE(sizeof(int32_t), CAPACITY, MAX_READERS)];
+static uint8_t raw_scaled[MULTI_READER_BUFFER_SIZE(sizeof(int32_t), CAPACITY, MAX_READERS)];
+static uint8_t raw_decimated[MULTI_READER_BUFFER_SIZE(sizeof(int32_t), CAPACITY, MAX_READERS)];
+static Buffer *input = (Buffer*) &raw_input;
+static Buffer *scaled = (Buffer*) &raw_scaled;
+static Buffer *decimated = (Buffer*) &raw_decimated;
+
+static Pipeline pipeline;
+static PipelineWorkers workers;
+static PipelineStage scale_stage;
+static PipelineStage decimate_stage;
+static PipelineStage sink_stage;
+
+static size_t decimation_counter;
+static int32_t next_expected_item;
+static size_t number_of_out_of_order_items;
+
+static void
+scale(PipelineStage *stage, void *context, const void *items, size_t count)
+{
+  int32_t results[CAPACITY];
+  const int32_t *samples = items;
+
+  for (size_t index = 0; index < count; index++)
+  {
+    results[index] = 3 * samples[index];
+  }
+  emitFromPipelineStage(stage, results, count);
+}
+
+static void
+decimate(PipelineStage *stage, void *context, const void *items, size_t count)
+{
+  size_t *counter = context;
+  const int32_t *samples = items;
+
+  for (size_t index = 0; index < count; index++)
+  {
+    if ((*counter)++ % 2 == 0)
+    {
+      emitFromPipelineStage(stage, samples + index, 1);
+    }
+  }
+}
+
+static void
+check(PipelineStage *stage, void *context, const void *items, size_t count)
+{
+  const int32_t *samples = items;
+
+  for (size_t index = 0; index < count; index++)
+  {
+    if (samples[index] != next_expected_item)
+    {
+      number_of_out_of_order_items++;
+    }
+    next_expected_item = samples[index] + 6;
+  }
+}
+
+static uint32_t
+microseconds(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint32_t) (now.tv_sec * 1000000 + now.tv_nsec / 1000);
+}
+
+static void
+addStage(PipelineStage *stage, PipelineStageFunction function, void *context, Buffer *from, Buffer *to)
+{
+  PipelineStageConfig config = {
+    .function = function,
+    .context = context,
+    .input = from,
+    .output = to,
+    .max_outputs_per_input = (to != NULL) ? 1 : 0,
+    .batch_size = CAPACITY / 4,
+  };
+
+  addStageToPipeline(&pipeline, stage, &config);
+}
+
+static void
+waitForSink(size_t number_of_items)
+{
+  PipelineStageMetrics metrics;
+
+  for (size_t attempt = 0; attempt < 100000; attempt++)
+  {
+    getPipelineStageMetrics(&pipeline, &sink_stage, &metrics);
+    if (metrics.consumed_items >= number_of_items)
+    {
+      return;
+    }
+    sched_yield();
+  }
+}
+
+void
+setUp(void)
+{
+  initMultiReaderBuffer((MultiReaderBuffer*) input, sizeof(int32_t), CAPACITY, MAX_READERS);
+  initMultiReaderBuffer((MultiReaderBuffer*) scaled, sizeof(int32_t), CAPACITY, MAX_READERS);
+  initMultiReaderBuffer((MultiReaderBuffer*) decimated, sizeof(int32_t), CAPACITY, MAX_READERS);
+  initPipeline(&pipeline);
+  setPipelineTimestampSource(&pipeline, microseconds);
+  addStage(&scale_stage, scale, NULL, input, scaled);
+  addStage(&decimate_stage, decimate, &decimation_counter, scaled, decimated);
+  addStage(&sink_stage, check, NULL, decimated, NULL);
+  decimation_counter = 0;
+  next_expected_item = 0;
+  number_of_out_of_order_items = 0;
+}
+
+void
+test_workersPassAllItemsThroughTheStagesInOrder(void)
+{
+  TEST_ASSERT_EQUAL(BUFFER_OK, startPipelineWorkers(&workers, &pipeline, 4));
+
+  for (int32_t next_item = 0; next_item < NUMBER_OF_ITEMS; next_item += PUSH_BURST)
+  {
+    int32_t burst[PUSH_BURST];
+
+    for (size_t index = 0; index < PUSH_BURST; index++)
+    {
+      burst[index] = next_item + (int32_t) index;
+    }
+    while (pushToPipeline(&pipeline, input, burst, PUSH_BURST) == BUFFER_FULL)
+    {
+      sched_yield();  // Backpressure from the stages
+    }
+  }
+
+  waitForSink(NUMBER_OF_ITEMS / 2);
+  stopPipelineWorkers(&workers);
+
+  PipelineStageMetrics scale_metrics;
+  PipelineStageMetrics decimate_metrics;
+  PipelineStageMetrics sink_metrics;
+
+  getPipelineStageMetrics(&pipeline, &scale_stage, &scale_metrics);
+  getPipelineStageMetrics(&pipeline, &decimate_stage, &decimate_metrics);
+  getPipelineStageMetrics(&pipeline, &sink_stage, &sink_metrics);
+
+  TEST_ASSERT_EQUAL(0, number_of_out_of_order_items);
+  TEST_ASSERT_EQUAL(NUMBER_OF_ITEMS, scale_metrics.consumed_items);
+  TEST_ASSERT_EQUAL(NUMBER_OF_ITEMS, scale_metrics.emitted_items);
+  TEST_ASSERT_EQUAL(NUMBER_OF_ITEMS / 2, decimate_metrics.emitted_items);
+  TEST_ASSERT_EQUAL(NUMBER_OF_ITEMS / 2, sink_metrics.consumed_items);
+  TEST_ASSERT_EQUAL(0, scale_metrics.dropped_items + decimate_metrics.dropped_items);
+  TEST_ASSERT_TRUE(scale_metrics.batches >= NUMBER_OF_ITEMS / (CAPACITY / 4));
+}
+
+void
+test_stoppedPipelineCanBeDrainedSingleThreaded(void)
+{
+  int32_t burst[PUSH_BURST] = {0, 1, 2, 3};
+
+  TEST_ASSERT_EQUAL(BUFFER_OK, startPipelineWorkers(&workers, &pipeline, 1));
+  stopPipelineWorkers(&workers);
+  TEST_ASSERT_EQUAL(BUFFER_OK, pushToPipeline(&pipeline, input, burst, 4));
+
+  while (runPipelineOnce(&pipeline) > 0)
+  {
+  }
+
+  TEST_ASSERT_EQUAL(0, number_of_out_of_order_items);
+  TEST_ASSERT_EQUAL(12, next_expected_item);
+}
+
+void
+test_invalidNumberOfWorkersIsRejected(void)
+{
+  TEST_ASSERT_EQUAL(BUFFER_INVALID_CAPACITY, startPipelineWorkers(&workers, &pipeline, 0));
+  TEST_ASSERT_EQUAL(BUFFER_INVALID_CAPACITY, startPipelineWorkers(&workers, &pipeline, PIPELINE_MAX_WORKERS + 1));
+}
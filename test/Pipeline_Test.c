@@ -0,0 +1,278 @@
+#include <unity.h>
+#include <CException.h>
+#include "EmbeddedUtilities/Pipeline.h"
+
+/*
+ * The stages are run single threaded here, as on the AVR target:
+ * input -> scale -> scaled -> decimate -> decimated -> sink
+ */
+
+#define CAPACITY (8)
+#define MAX_READERS (2)
+#define MAX_SINK_ITEMS (64)
+
+static uint8_t raw_input[MULTI_READER_BUFFER_SIZE(sizeof(int16_t), CAPACITY, MAX_READERS)];
+static uint8_t raw_scaled[MULTI_READER_BUFFER_SIZE(sizeof(int16_t), CAPACITY, MAX_READERS)];
+static uint8_t raw_decimated[MULTI_READER_BUFFER_SIZE(sizeof(int16_t), CAPACITY, MAX_READERS)];
+static Buffer *input = (Buffer*) &raw_input;
+static Buffer *scaled = (Buffer*) &raw_scaled;
+static Buffer *decimated = (Buffer*) &raw_decimated;
+
+static Pipeline pipeline;
+static PipelineStage scale_stage;
+static PipelineStage decimate_stage;
+static PipelineStage sink_stage;
+
+static size_t decimation_counter;
+static int16_t sink_items[MAX_SINK_ITEMS];
+static size_t number_of_sink_items;
+static size_t sink_batches[MAX_SINK_ITEMS];
+static size_t number_of_sink_batches;
+static uint32_t fake_time;
+
+static void
+scale(PipelineStage *stage, void *context, const void *items, size_t count)
+{
+  int16_t results[CAPACITY];
+  const int16_t *samples = items;
+
+  for (size_t index = 0; index < count; index++)
+  {
+    results[index] = (int16_t) (2 * samples[index]);
+  }
+  emitFromPipelineStage(stage, results, count);
+}
+
+static void
+decimate(PipelineStage *stage, void *context, const void *items, size_t count)
+{
+  size_t *counter = context;
+  const int16_t *samples = items;
+
+  for (size_t index = 0; index < count; index++)
+  {
+    if ((*counter)++ % 2 == 0)
+    {
+      emitFromPipelineStage(stage, samples + index, 1);
+    }
+  }
+}
+
+static void
+collect(PipelineStage *stage, void *context, const void *items, size_t count)
+{
+  const int16_t *samples = items;
+
+  for (size_t index = 0; index < count; index++)
+  {
+    sink_items[number_of_sink_items++] = samples[index];
+  }
+  sink_batches[number_of_sink_batches++] = count;
+}
+
+static void
+duplicate(PipelineStage *stage, void *context, const void *items, size_t count)
+{
+  emitFromPipelineStage(stage, items, count);
+  emitFromPipelineStage(stage, items, count);
+}
+
+static uint32_t
+advanceFakeTime(void)
+{
+  fake_time += 5;
+  return fake_time;
+}
+
+static void
+addStage(PipelineStage *stage, PipelineStageFunction function, void *context, Buffer *from, Buffer *to, size_t batch_size)
+{
+  PipelineStageConfig config = {
+    .function = function,
+    .context = context,
+    .input = from,
+    .output = to,
+    .max_outputs_per_input = (to != NULL) ? 1 : 0,
+    .batch_size = batch_size,
+  };
+
+  addStageToPipeline(&pipeline, stage, &config);
+}
+
+static void
+pushSequence(int16_t first, size_t count)
+{
+  for (size_t index = 0; index < count; index++)
+  {
+    int16_t item = (int16_t) (first + index);
+
+    TEST_ASSERT_EQUAL(BUFFER_OK, pushToPipeline(&pipeline, input, &item, 1));
+  }
+}
+
+static void
+runUntilIdle(void)
+{
+  while (runPipelineOnce(&pipeline) > 0)
+  {
+  }
+}
+
+void
+setUp(void)
+{
+  initMultiReaderBuffer((MultiReaderBuffer*) input, sizeof(int16_t), CAPACITY, MAX_READERS);
+  initMultiReaderBuffer((MultiReaderBuffer*) scaled, sizeof(int16_t), CAPACITY, MAX_READERS);
+  initMultiReaderBuffer((MultiReaderBuffer*) decimated, sizeof(int16_t), CAPACITY, MAX_READERS);
+  initPipeline(&pipeline);
+  decimation_counter = 0;
+  number_of_sink_items = 0;
+  number_of_sink_batches = 0;
+  fake_time = 0;
+}
+
+void
+test_itemsPassAllStagesInOrder(void)
+{
+  addStage(&scale_stage, scale, NULL, input, scaled, 0);
+  addStage(&decimate_stage, decimate, &decimation_counter, scaled, decimated, 0);
+  addStage(&sink_stage, collect, NULL, decimated, NULL, 0);
+
+  pushSequence(1, 6);
+  runUntilIdle();
+
+  TEST_ASSERT_EQUAL(3, number_of_sink_items);
+  TEST_ASSERT_EQUAL_INT16(2, sink_items[0]);
+  TEST_ASSERT_EQUAL_INT16(6, sink_items[1]);
+  TEST_ASSERT_EQUAL_INT16(10, sink_items[2]);
+  TEST_ASSERT_FALSE(readableItemExistsForReader(input, scale_stage.reader_descriptor));
+  TEST_ASSERT_FALSE(readableItemExistsForReader(scaled, decimate_stage.reader_descriptor));
+}
+
+void
+test_fullOutputStallsStageAndPushesAreRejectedWithoutLosingItems(void)
+{
+  addStage(&scale_stage, scale, NULL, input, scaled, 0);
+  addStage(&sink_stage, collect, NULL, scaled, NULL, 0);
+
+  pushSequence(0, CAPACITY);
+  while (runPipelineStage(&pipeline, &scale_stage) > 0)
+  {
+  }
+  pushSequence(CAPACITY, CAPACITY);
+
+  int16_t item = 100;
+  PipelineStageMetrics metrics;
+
+  TEST_ASSERT_EQUAL(0, runPipelineStage(&pipeline, &scale_stage));
+  TEST_ASSERT_EQUAL(BUFFER_FULL, pushToPipeline(&pipeline, input, &item, 1));
+  getPipelineStageMetrics(&pipeline, &scale_stage, &metrics);
+  TEST_ASSERT_EQUAL(1, metrics.stalls);
+
+  runUntilIdle();
+
+  TEST_ASSERT_EQUAL(2 * CAPACITY, number_of_sink_items);
+  for (size_t index = 0; index < 2 * CAPACITY; index++)
+  {
+    TEST_ASSERT_EQUAL_INT16(2 * index, sink_items[index]);
+  }
+  TEST_ASSERT_EQUAL(0, getNumberOfLostElementsForReader(scaled, sink_stage.reader_descriptor));
+}
+
+void
+test_batchSizeLimitsItemsPerCall(void)
+{
+  addStage(&sink_stage, collect, NULL, input, NULL, 3);
+
+  pushSequence(0, 7);
+  runUntilIdle();
+
+  TEST_ASSERT_EQUAL(3, number_of_sink_batches);
+  TEST_ASSERT_EQUAL(3, sink_batches[0]);
+  TEST_ASSERT_EQUAL(3, sink_batches[1]);
+  TEST_ASSERT_EQUAL(1, sink_batches[2]);
+}
+
+void
+test_wrappedItemsAreHandedOverAsSecondBatch(void)
+{
+  addStage(&sink_stage, collect, NULL, input, NULL, 0);
+
+  pushSequence(0, 6);
+  runUntilIdle();
+  pushSequence(6, 6);
+  runUntilIdle();
+
+  TEST_ASSERT_EQUAL(12, number_of_sink_items);
+  TEST_ASSERT_EQUAL(3, number_of_sink_batches);
+  TEST_ASSERT_EQUAL(CAPACITY + 1 - 6, sink_batches[1]);
+  for (size_t index = 0; index < 12; index++)
+  {
+    TEST_ASSERT_EQUAL_INT16(index, sink_items[index]);
+  }
+}
+
+void
+test_metricsCountItemsBatchesAndTimeOfEachStage(void)
+{
+  PipelineStageMetrics metrics;
+
+  setPipelineTimestampSource(&pipeline, advanceFakeTime);
+  addStage(&scale_stage, scale, NULL, input, scaled, 2);
+  addStage(&decimate_stage, decimate, &decimation_counter, scaled, decimated, 0);
+  addStage(&sink_stage, collect, NULL, decimated, NULL, 0);
+
+  pushSequence(0, 6);
+  runUntilIdle();
+
+  getPipelineStageMetrics(&pipeline, &scale_stage, &metrics);
+  TEST_ASSERT_EQUAL(6, metrics.consumed_items);
+  TEST_ASSERT_EQUAL(6, metrics.emitted_items);
+  TEST_ASSERT_EQUAL(3, metrics.batches);
+  TEST_ASSERT_EQUAL(15, metrics.busy_time);
+  TEST_ASSERT_EQUAL(5, metrics.max_batch_time);
+  TEST_ASSERT_EQUAL(0, metrics.dropped_items);
+
+  getPipelineStageMetrics(&pipeline, &decimate_stage, &metrics);
+  TEST_ASSERT_EQUAL(6, metrics.consumed_items);
+  TEST_ASSERT_EQUAL(3, metrics.emitted_items);
+
+  getPipelineStageMetrics(&pipeline, &sink_stage, &metrics);
+  TEST_ASSERT_EQUAL(3, metrics.consumed_items);
+  TEST_ASSERT_EQUAL(0, metrics.emitted_items);
+}
+
+void
+test_itemsEmittedBeyondTheDeclaredRatioAreDroppedWhenOutputIsFull(void)
+{
+  PipelineStageMetrics metrics;
+
+  addStage(&scale_stage, duplicate, NULL, input, scaled, 0);
+  getNewBufferReaderDescriptor(scaled);  // Never reads, so the output fills up
+
+  pushSequence(0, 6);
+  runUntilIdle();
+
+  getPipelineStageMetrics(&pipeline, &scale_stage, &metrics);
+  TEST_ASSERT_EQUAL(6, metrics.emitted_items);
+  TEST_ASSERT_EQUAL(6, metrics.dropped_items);
+}
+
+void
+test_addingStageThrowsIfInputHasNoFreeReaderSlot(void)
+{
+  CEXCEPTION_T e = 0;
+
+  addStage(&scale_stage, scale, NULL, input, scaled, 0);
+  addStage(&decimate_stage, scale, NULL, input, decimated, 0);
+
+  Try
+  {
+    addStage(&sink_stage, collect, NULL, input, NULL, 0);
+    TEST_FAIL_MESSAGE("Exception not thrown!");
+  }
+  Catch (e)
+  {
+    TEST_ASSERT_EQUAL(BUFFER_NO_FREE_READER_SLOTS_EXCEPTION, e);
+  }
+}
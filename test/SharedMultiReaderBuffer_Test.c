@@ -0,0 +1,166 @@
+#include <unity.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "EmbeddedUtilities/SharedMultiReaderBuffer.h"
+
+#define MAX_ELEMENTS (64)
+#define MAX_READERS (4)
+#define NUMBER_OF_CONSUMERS (2)
+#define NUMBER_OF_ITEMS (100000)
+
+static char name[64];
+static SharedMultiReaderBuffer producer;
+
+void
+setUp(void)
+{
+  snprintf(name, sizeof(name), "/SharedMultiReaderBuffer_Test-%d", (int) getpid());
+  removeSharedMultiReaderBuffer(name);
+}
+
+void
+tearDown(void)
+{
+  removeSharedMultiReaderBuffer(name);
+}
+
+void
+test_attachToMissingBufferFails(void)
+{
+  SharedMultiReaderBuffer consumer;
+  TEST_ASSERT_EQUAL(BUFFER_UNAVAILABLE, attachSharedMultiReaderBuffer(&consumer, name));
+}
+
+void
+test_createTwiceFails(void)
+{
+  TEST_ASSERT_EQUAL(BUFFER_OK, createSharedMultiReaderBuffer(&producer, name, sizeof(uint64_t), MAX_ELEMENTS, MAX_READERS, MULTI_READER_BUFFER_DEFAULT_OPTIONS));
+
+  SharedMultiReaderBuffer second_producer;
+  TEST_ASSERT_EQUAL(BUFFER_UNAVAILABLE, createSharedMultiReaderBuffer(&second_producer, name, sizeof(uint64_t), MAX_ELEMENTS, MAX_READERS, MULTI_READER_BUFFER_DEFAULT_OPTIONS));
+
+  detachSharedMultiReaderBuffer(&producer);
+}
+
+void
+test_createWithInvalidCapacityFailsAndLeavesNoBufferBehind(void)
+{
+  TEST_ASSERT_EQUAL(BUFFER_INVALID_CAPACITY, createSharedMultiReaderBuffer(&producer, name, sizeof(uint64_t), 48, MAX_READERS, MULTI_READER_BUFFER_DEFAULT_OPTIONS));
+
+  SharedMultiReaderBuffer consumer;
+  TEST_ASSERT_EQUAL(BUFFER_UNAVAILABLE, attachSharedMultiReaderBuffer(&consumer, name));
+}
+
+void
+test_attachedMappingSharesReaderSlotsAndItems(void)
+{
+  createSharedMultiReaderBuffer(&producer, name, sizeof(uint64_t), MAX_ELEMENTS, MAX_READERS, MULTI_READER_BUFFER_DEFAULT_OPTIONS);
+
+  SharedMultiReaderBuffer consumer;
+  TEST_ASSERT_EQUAL(BUFFER_OK, attachSharedMultiReaderBuffer(&consumer, name));
+  TEST_ASSERT_NOT_EQUAL(producer.mapping, consumer.mapping);
+
+  uint8_t reader;
+  getNewConcurrentBufferReaderDescriptor(consumer.buffer, &reader);
+
+  uint64_t value = 42;
+  pushToConcurrentBuffer(producer.buffer, &value);
+
+  value = 0;
+  TEST_ASSERT_EQUAL(BUFFER_OK, popFromConcurrentBufferWithReader(consumer.buffer, reader, &value));
+  TEST_ASSERT_EQUAL_UINT64(42, value);
+
+  detachSharedMultiReaderBuffer(&consumer);
+  detachSharedMultiReaderBuffer(&producer);
+}
+
+/*
+ * Consumer processes report their result via exit code. They signal through
+ * the pipe once they have claimed a reader, so they do not miss the first items.
+ */
+
+static int
+consumeInChildProcess(int ready_pipe)
+{
+  SharedMultiReaderBuffer consumer;
+  uint8_t reader;
+
+  if (attachSharedMultiReaderBuffer(&consumer, name) != BUFFER_OK
+      || getNewConcurrentBufferReaderDescriptor(consumer.buffer, &reader) != BUFFER_OK)
+  {
+    return 1;
+  }
+
+  char ready = 1;
+  if (write(ready_pipe, &ready, 1) != 1)
+  {
+    return 1;
+  }
+
+  for (uint64_t expected = 0; expected < NUMBER_OF_ITEMS;)
+  {
+    uint64_t value;
+    BufferStatus status = popFromConcurrentBufferWithReader(consumer.buffer, reader, &value);
+
+    if (status == BUFFER_OK)
+    {
+      if (value != expected)
+      {
+        return 2;
+      }
+      expected++;
+    }
+    else if (status != BUFFER_EMPTY)
+    {
+      return 3;
+    }
+  }
+
+  deleteConcurrentBufferReaderDescriptor(consumer.buffer, reader);
+  detachSharedMultiReaderBuffer(&consumer);
+  return 0;
+}
+
+void
+test_producerProcessAndConsumerProcessesExchangeItemsWithoutLoss(void)
+{
+  TEST_ASSERT_EQUAL(BUFFER_OK, createSharedMultiReaderBuffer(&producer, name, sizeof(uint64_t), MAX_ELEMENTS, MAX_READERS, MULTI_READER_BUFFER_BLOCK_WHEN_FULL));
+
+  int ready_pipe[2];
+  pid_t consumers[NUMBER_OF_CONSUMERS];
+
+  TEST_ASSERT_EQUAL(0, pipe(ready_pipe));
+
+  for (size_t index = 0; index < NUMBER_OF_CONSUMERS; index++)
+  {
+    consumers[index] = fork();
+    if (consumers[index] == 0)
+    {
+      _exit(consumeInChildProcess(ready_pipe[1]));
+    }
+  }
+
+  for (size_t index = 0; index < NUMBER_OF_CONSUMERS; index++)
+  {
+    char ready;
+    TEST_ASSERT_EQUAL(1, read(ready_pipe[0], &ready, 1));
+  }
+
+  for (uint64_t value = 0; value < NUMBER_OF_ITEMS; value++)
+  {
+    pushToConcurrentBuffer(producer.buffer, &value);
+  }
+
+  for (size_t index = 0; index < NUMBER_OF_CONSUMERS; index++)
+  {
+    int exit_status;
+    waitpid(consumers[index], &exit_status, 0);
+    TEST_ASSERT_TRUE(WIFEXITED(exit_status));
+    TEST_ASSERT_EQUAL(0, WEXITSTATUS(exit_status));
+  }
+
+  close(ready_pipe[0]);
+  close(ready_pipe[1]);
+  detachSharedMultiReaderBuffer(&producer);
+}
@@ -0,0 +1,257 @@
+#include <unity.h>
+#include <CException.h>
+#include "EmbeddedUtilities/TypedMultiReaderBuffer.h"
+
+/*
+ * Every test performs the same operations on a generated buffer
+ * and on a generic MultiReaderBuffer with a power of two capacity
+ * and expects identical items, statuses, exceptions and lost counts.
+ */
+
+#define CAPACITY (8)
+#define MAX_READERS (3)
+
+typedef struct Sample
+{
+  uint32_t sequence;
+  int16_t value;
+} Sample;
+
+MULTI_READER_BUFFER_DEFINE(SampleBuffer, Sample, CAPACITY, MAX_READERS)
+
+static SampleBuffer typed_buffer;
+static uint8_t raw_memory[MULTI_READER_BUFFER_SIZE(sizeof(Sample), CAPACITY, MAX_READERS)];
+static Buffer *generic_buffer = (Buffer*) &raw_memory;
+static uint32_t next_sequence;
+
+static void
+pushToBoth(size_t count)
+{
+  for (size_t index = 0; index < count; index++)
+  {
+    Sample sample = {.sequence = next_sequence, .value = (int16_t) (next_sequence * -3)};
+    next_sequence++;
+
+    pushToSampleBuffer(&typed_buffer, sample);
+    pushToBuffer(generic_buffer, &sample);
+  }
+}
+
+static CEXCEPTION_T
+popFromTypedBuffer(uint8_t reader, Sample *sample)
+{
+  CEXCEPTION_T e = 0;
+
+  Try
+  {
+    *sample = popFromSampleBufferWithReader(&typed_buffer, reader);
+  }
+  Catch (e)
+  {
+  }
+
+  return e;
+}
+
+static CEXCEPTION_T
+popFromGenericBuffer(uint8_t reader, Sample *sample)
+{
+  CEXCEPTION_T e = 0;
+
+  Try
+  {
+    *sample = *(const Sample*) popFromBufferWithReader(generic_buffer, reader);
+  }
+  Catch (e)
+  {
+  }
+
+  return e;
+}
+
+static CEXCEPTION_T
+popFromBothAndCompare(uint8_t reader)
+{
+  Sample typed_sample = {0};
+  Sample generic_sample = {0};
+
+  CEXCEPTION_T typed_exception = popFromTypedBuffer(reader, &typed_sample);
+  CEXCEPTION_T generic_exception = popFromGenericBuffer(reader, &generic_sample);
+
+  TEST_ASSERT_EQUAL(generic_exception, typed_exception);
+  TEST_ASSERT_EQUAL_UINT32(generic_sample.sequence, typed_sample.sequence);
+  TEST_ASSERT_EQUAL_INT16(generic_sample.value, typed_sample.value);
+  TEST_ASSERT_EQUAL(getNumberOfLostElementsForReader(generic_buffer, reader),
+                    getNumberOfLostElementsForSampleBufferReader(&typed_buffer, reader));
+  TEST_ASSERT_EQUAL(readableItemExistsForReader(generic_buffer, reader),
+                    readableItemExistsForSampleBufferReader(&typed_buffer, reader));
+
+  return generic_exception;
+}
+
+static uint8_t
+getNewReaderOfBoth(void)
+{
+  uint8_t typed_reader = getNewSampleBufferReaderDescriptor(&typed_buffer);
+  uint8_t generic_reader = getNewBufferReaderDescriptor(generic_buffer);
+
+  TEST_ASSERT_EQUAL_UINT8(generic_reader, typed_reader);
+
+  return typed_reader;
+}
+
+void
+setUp(void)
+{
+  initSampleBuffer(&typed_buffer);
+  initMultiReaderBufferWithOptions((MultiReaderBuffer*) generic_buffer, sizeof(Sample), CAPACITY, MAX_READERS,
+                                   MULTI_READER_BUFFER_POWER_OF_TWO_CAPACITY);
+  next_sequence = 0;
+}
+
+void
+test_popItemsInOrderLikeGenericBuffer(void)
+{
+  uint8_t reader = getNewReaderOfBoth();
+
+  pushToBoth(5);
+
+  for (size_t index = 0; index < 5; index++)
+  {
+    TEST_ASSERT_EQUAL(0, popFromBothAndCompare(reader));
+  }
+  TEST_ASSERT_EQUAL(BUFFER_UNDERRUN_EXCEPTION, popFromBothAndCompare(reader));
+}
+
+void
+test_peekDoesNotAdvanceReader(void)
+{
+  uint8_t reader = getNewReaderOfBoth();
+
+  pushToBoth(2);
+
+  Sample peeked = peekAtSampleBufferWithReader(&typed_buffer, reader);
+  const Sample *generic_peeked = peekAtBufferWithReader(generic_buffer, reader);
+
+  TEST_ASSERT_EQUAL_UINT32(generic_peeked->sequence, peeked.sequence);
+  TEST_ASSERT_EQUAL_UINT32(0, peekAtSampleBufferWithReader(&typed_buffer, reader).sequence);
+  TEST_ASSERT_EQUAL(0, popFromBothAndCompare(reader));
+  TEST_ASSERT_EQUAL(0, popFromBothAndCompare(reader));
+}
+
+void
+test_overrunIsReportedAndReaderContinuesWithOldestItem(void)
+{
+  uint8_t reader = getNewReaderOfBoth();
+
+  pushToBoth(CAPACITY + 3);
+
+  TEST_ASSERT_EQUAL(BUFFER_OVERRUN_EXCEPTION, popFromBothAndCompare(reader));
+  TEST_ASSERT_EQUAL(3, getNumberOfLostElementsForSampleBufferReader(&typed_buffer, reader));
+
+  for (size_t index = 0; index < CAPACITY; index++)
+  {
+    TEST_ASSERT_EQUAL(0, popFromBothAndCompare(reader));
+  }
+  TEST_ASSERT_EQUAL(BUFFER_UNDERRUN_EXCEPTION, popFromBothAndCompare(reader));
+}
+
+void
+test_readersAtDifferentPositionsMatchGenericBufferOverManyLaps(void)
+{
+  uint8_t fast_reader = getNewReaderOfBoth();
+  uint8_t slow_reader = getNewReaderOfBoth();
+
+  for (size_t round = 1; round <= 40; round++)
+  {
+    pushToBoth(round % 11);
+
+    while (readableItemExistsForSampleBufferReader(&typed_buffer, fast_reader))
+    {
+      popFromBothAndCompare(fast_reader);
+    }
+
+    if (round % 3 == 0)
+    {
+      popFromBothAndCompare(slow_reader);
+    }
+  }
+
+  while (popFromBothAndCompare(slow_reader) != BUFFER_UNDERRUN_EXCEPTION)
+  {
+  }
+}
+
+void
+test_newReaderStartsAtOldestItem(void)
+{
+  pushToBoth(CAPACITY + 5);
+
+  uint8_t reader = getNewReaderOfBoth();
+
+  TEST_ASSERT_EQUAL(0, popFromBothAndCompare(reader));
+  TEST_ASSERT_EQUAL_UINT32(6, peekAtSampleBufferWithReader(&typed_buffer, reader).sequence);
+}
+
+void
+test_tryPopReturnsSameStatusesAsGenericBuffer(void)
+{
+  uint8_t reader = getNewReaderOfBoth();
+  Sample sample;
+  const void *item;
+
+  TEST_ASSERT_EQUAL(tryPopFromBufferWithReader(generic_buffer, reader, &item),
+                    tryPopFromSampleBufferWithReader(&typed_buffer, reader, &sample));
+
+  pushToBoth(2 * CAPACITY + 1);
+
+  TEST_ASSERT_EQUAL(BUFFER_OVERRUN, tryPopFromSampleBufferWithReader(&typed_buffer, reader, &sample));
+  TEST_ASSERT_EQUAL(BUFFER_OVERRUN, tryPopFromBufferWithReader(generic_buffer, reader, &item));
+  TEST_ASSERT_EQUAL(BUFFER_OK, tryPopFromSampleBufferWithReader(&typed_buffer, reader, &sample));
+  TEST_ASSERT_EQUAL(BUFFER_OK, tryPopFromBufferWithReader(generic_buffer, reader, &item));
+  TEST_ASSERT_EQUAL_UINT32(((const Sample*) item)->sequence, sample.sequence);
+  TEST_ASSERT_EQUAL(BUFFER_INVALID_READER, tryPopFromSampleBufferWithReader(&typed_buffer, MAX_READERS, &sample));
+}
+
+void
+test_readerSlotsAreLimitedAndReusable(void)
+{
+  CEXCEPTION_T e = 0;
+
+  for (size_t index = 0; index < MAX_READERS; index++)
+  {
+    getNewReaderOfBoth();
+  }
+
+  Try
+  {
+    getNewSampleBufferReaderDescriptor(&typed_buffer);
+    TEST_FAIL_MESSAGE("Exception not thrown!");
+  }
+  Catch (e)
+  {
+    TEST_ASSERT_EQUAL(BUFFER_NO_FREE_READER_SLOTS_EXCEPTION, e);
+  }
+
+  deleteSampleBufferReaderDescriptor(&typed_buffer, 1);
+  deleteBufferReaderDescriptor(generic_buffer, 1);
+
+  TEST_ASSERT_EQUAL_UINT8(1, getNewReaderOfBoth());
+}
+
+void
+test_invalidReaderThrows(void)
+{
+  CEXCEPTION_T e = 0;
+
+  Try
+  {
+    popFromSampleBufferWithReader(&typed_buffer, 0);
+    TEST_FAIL_MESSAGE("Exception not thrown!");
+  }
+  Catch (e)
+  {
+    TEST_ASSERT_EQUAL(BUFFER_INVALID_READER_EXCEPTION, e);
+  }
+  TEST_ASSERT_FALSE(readableItemExistsForSampleBufferReader(&typed_buffer, MAX_READERS));
+}
@@ -0,0 +1,206 @@
+#include <unity.h>
+#include <CException.h>
+#include <stdlib.h>
+#include <math.h>
+#include "EmbeddedUtilities/WindowStatistics.h"
+
+#define WINDOW_LENGTH (10)
+#define NUMBER_OF_SAMPLES (500)
+
+static uint8_t raw_memory[WINDOW_STATISTICS_SIZE(sizeof(int32_t), WINDOW_LENGTH)];
+static WindowStatistics *window = (WindowStatistics*) &raw_memory;
+static uint8_t raw_memory_batch_window[WINDOW_STATISTICS_SIZE(sizeof(int32_t), WINDOW_LENGTH)];
+static WindowStatistics *batch_window = (WindowStatistics*) &raw_memory_batch_window;
+
+static double
+sampleAsDouble(WindowSampleType sample_type, const void *samples, size_t index)
+{
+  if (sample_type == WINDOW_SAMPLES_INT16)
+  {
+    return ((const int16_t*) samples)[index];
+  }
+
+  if (sample_type == WINDOW_SAMPLES_INT32)
+  {
+    return ((const int32_t*) samples)[index];
+  }
+
+  return ((const float*) samples)[index];
+}
+
+static float
+relativeError(double expected, double actual)
+{
+  return (float) ((actual - expected) / (1 + fabs(expected)));
+}
+
+static double
+windowSampleAsDouble(WindowSampleType sample_type, WindowSample sample)
+{
+  return sampleAsDouble(sample_type, &sample, 0);
+}
+
+/* Walks through the latest samples the way the window avoids it */
+
+static void
+checkAgainstRecalculation(WindowSampleType sample_type, const void *samples, size_t count, const WindowStatisticsSummary *summary)
+{
+  size_t first = (count > WINDOW_LENGTH) ? count - WINDOW_LENGTH : 0;
+  double minimum = sampleAsDouble(sample_type, samples, first);
+  double maximum = minimum;
+  double sum = 0;
+
+  for (size_t index = first; index < count; index++)
+  {
+    double value = sampleAsDouble(sample_type, samples, index);
+
+    minimum = (value < minimum) ? value : minimum;
+    maximum = (value > maximum) ? value : maximum;
+    sum += value;
+  }
+
+  double mean = sum / (count - first);
+  double variance = 0;
+
+  for (size_t index = first; index < count; index++)
+  {
+    double deviation = sampleAsDouble(sample_type, samples, index) - mean;
+    variance += deviation * deviation;
+  }
+  variance /= (count - first);
+
+  TEST_ASSERT_EQUAL(count - first, summary->number_of_samples);
+  TEST_ASSERT_TRUE(minimum == windowSampleAsDouble(sample_type, summary->minimum));
+  TEST_ASSERT_TRUE(maximum == windowSampleAsDouble(sample_type, summary->maximum));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, relativeError(mean, summary->mean));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, relativeError(variance, summary->variance));
+}
+
+static void
+checkSingleAndBatchUpdates(WindowSampleType sample_type, const void *samples, size_t sample_size)
+{
+  WindowStatisticsSummary summary;
+  size_t batch_start = 0;
+
+  initWindowStatistics(window, sample_type, WINDOW_LENGTH);
+  initWindowStatistics(batch_window, sample_type, WINDOW_LENGTH);
+
+  for (size_t count = 1; count <= NUMBER_OF_SAMPLES; count++)
+  {
+    addSampleToWindow(window, (const uint8_t*) samples + (count - 1) * sample_size);
+    getWindowStatistics(window, &summary);
+    checkAgainstRecalculation(sample_type, samples, count, &summary);
+
+    if (count % 7 == 0 || count % 23 == 0)  // Batches of varying length, some longer than the window
+    {
+      addSamplesToWindow(batch_window, (const uint8_t*) samples + batch_start * sample_size, count - batch_start);
+      batch_start = count;
+      getWindowStatistics(batch_window, &summary);
+      checkAgainstRecalculation(sample_type, samples, count, &summary);
+    }
+  }
+}
+
+void
+setUp(void)
+{
+  srand(42);
+}
+
+void
+test_emptyWindowReportsNoSamples(void)
+{
+  WindowStatisticsSummary summary;
+
+  initWindowStatistics(window, WINDOW_SAMPLES_INT16, WINDOW_LENGTH);
+  getWindowStatistics(window, &summary);
+
+  TEST_ASSERT_EQUAL(0, summary.number_of_samples);
+  TEST_ASSERT_TRUE(summary.mean == 0);
+}
+
+void
+test_int16SamplesMatchRecalculation(void)
+{
+  int16_t samples[NUMBER_OF_SAMPLES];
+
+  for (size_t index = 0; index < NUMBER_OF_SAMPLES; index++)
+  {
+    samples[index] = (int16_t) (rand() % 65536 - 32768);
+  }
+
+  checkSingleAndBatchUpdates(WINDOW_SAMPLES_INT16, samples, sizeof(int16_t));
+}
+
+void
+test_int32SamplesMatchRecalculation(void)
+{
+  int32_t samples[NUMBER_OF_SAMPLES];
+
+  for (size_t index = 0; index < NUMBER_OF_SAMPLES; index++)
+  {
+    samples[index] = (rand() % 2000001) - 1000000;
+  }
+
+  checkSingleAndBatchUpdates(WINDOW_SAMPLES_INT32, samples, sizeof(int32_t));
+}
+
+void
+test_floatSamplesMatchRecalculation(void)
+{
+  float samples[NUMBER_OF_SAMPLES];
+
+  for (size_t index = 0; index < NUMBER_OF_SAMPLES; index++)
+  {
+    samples[index] = (float) rand() / RAND_MAX * 200.0f - 100.0f;
+  }
+
+  checkSingleAndBatchUpdates(WINDOW_SAMPLES_FLOAT, samples, sizeof(float));
+}
+
+void
+test_monotonicSamplesKeepMinimumAndMaximumCorrect(void)
+{
+  int32_t samples[NUMBER_OF_SAMPLES];
+
+  for (int32_t index = 0; index < NUMBER_OF_SAMPLES; index++)
+  {
+    int32_t phase = index % (4 * WINDOW_LENGTH);
+
+    samples[index] = (phase < 2 * WINDOW_LENGTH) ? phase : 4 * WINDOW_LENGTH - phase;  // Rising, then falling, longer than the window each
+  }
+
+  checkSingleAndBatchUpdates(WINDOW_SAMPLES_INT32, samples, sizeof(int32_t));
+}
+
+#define BUFFER_MAX_ELEMENTS (16)
+
+static uint8_t raw_memory_buffer[MULTI_READER_BUFFER_SIZE(sizeof(int16_t), BUFFER_MAX_ELEMENTS, 1)];
+static Buffer *buffer = (Buffer*) &raw_memory_buffer;
+
+void
+test_addSamplesFromBufferReaderConsumesUnreadSamples(void)
+{
+  int16_t samples[2 * BUFFER_MAX_ELEMENTS];
+  WindowStatisticsSummary summary;
+
+  initMultiReaderBuffer((MultiReaderBuffer*) buffer, sizeof(int16_t), BUFFER_MAX_ELEMENTS, 1);
+  initWindowStatistics(window, WINDOW_SAMPLES_INT16, WINDOW_LENGTH);
+  uint8_t reader = getNewBufferReaderDescriptor(buffer);
+
+  for (int16_t index = 0; index < 2 * BUFFER_MAX_ELEMENTS; index++)
+  {
+    samples[index] = (int16_t) (index * index - 100);
+    pushToBuffer(buffer, samples + index);
+
+    if (index % 5 == 4)  // Some of the unread samples wrap around the end of the buffer memory
+    {
+      addSamplesFromBufferReader(window, buffer, reader);
+      getWindowStatistics(window, &summary);
+      checkAgainstRecalculation(WINDOW_SAMPLES_INT16, samples, index + 1, &summary);
+    }
+  }
+
+  TEST_ASSERT_EQUAL(2, addSamplesFromBufferReader(window, buffer, reader));
+  TEST_ASSERT_FALSE(readableItemExistsForReader(buffer, reader));
+}